@@ -22,6 +22,8 @@
 #include "sst/core/mempool.h"
 
 #include <unordered_map>
+#include <memory>
+#include <vector>
 #include <cinttypes>
 #include <cstring>
 
@@ -233,35 +235,23 @@ public:
     /** Allocates memory from a memory pool for a new Activity */
     void* operator new(std::size_t size) noexcept
     {
-        /* 1) Find memory pool
-         * 1.5) If not found, create new
+        /* 1) Find this thread's magazine for the size class
+         * 1.5) If not found, find or create the pool
          * 2) Alloc item from pool
          * 3) Append PoolID to item, increment pointer
          */
-        Core::MemPool *pool = nullptr;
-        size_t nPools = memPools.size();
-        std::thread::id tid = std::this_thread::get_id();
-        for ( size_t i = 0 ; i < nPools ; i++ ) {
-            PoolInfo_t &p = memPools[i];
-            if ( p.tid == tid && p.size == size ) {
-                pool = p.pool;
-                break;
-            }
-        }
-        if ( nullptr == pool ) {
-            /* Still can't find it, alloc a new one */
-            pool = new Core::MemPool(size+sizeof(PoolData_t));
+        size_t size_class = (size + sizeof(PoolData_t) - 1) / sizeof(PoolData_t);
+        std::vector<Core::MemPool::Magazine*>& by_size = poolCache.bySize;
+        Core::MemPool::Magazine* mag = nullptr;
+        if ( LIKELY(size_class < by_size.size()) ) mag = by_size[size_class];
+        if ( nullptr == mag ) mag = &getSizeMagazine(size_class);
 
-            std::lock_guard<std::mutex> lock(poolMutex);
-            memPools.emplace_back(tid, size, pool);
-        }
-
-        PoolData_t *ptr = (PoolData_t*)pool->malloc();
+        PoolData_t *ptr = (PoolData_t*)mag->getPool()->malloc(*mag);
         if ( !ptr ) {
             fprintf(stderr, "Memory Pool failed to allocate a new object.  Error: %s\n", strerror(errno));
             return nullptr;
         }
-        *ptr = pool;
+        *ptr = mag->getPool();
         return (void*)(ptr+1);
     }
 
@@ -278,7 +268,7 @@ public:
         Core::MemPool* pool = *ptr8;
         *ptr8 = nullptr;
 
-        pool->free(ptr8);
+        pool->free(ptr8, getPoolMagazine(pool));
     }
     void operator delete(void* ptr, std::size_t UNUSED(sz)){
         /* 1) Decrement pointer
@@ -290,15 +280,67 @@ public:
         Core::MemPool* pool = *ptr8;
         *ptr8 = nullptr;
 
-        pool->free(ptr8);
+        pool->free(ptr8, getPoolMagazine(pool));
     };
 
+    /** Return the Activities cached by the calling thread to their
+     * pools.  Only needed with MemPool::RECLAIM, where cached
+     * Activities keep arenas from being released. */
+    static void flushPoolMagazines() {
+        if ( !(memPoolFlags & Core::MemPool::RECLAIM) ) return;
+        for ( auto& mag : poolCache.byPool ) {
+            if ( mag ) mag->getPool()->flush(*mag);
+        }
+    }
+
     static void getMemPoolUsage(uint64_t& bytes, uint64_t& active_activities) {
+        uint64_t local_frees, remote_frees;
+        getMemPoolUsage(bytes, active_activities, local_frees, remote_frees);
+    }
+
+    /** Returns memory pool usage.  local_frees and remote_frees count
+     * Activities deleted by the thread that allocated them and by
+     * other threads, respectively. */
+    static void getMemPoolUsage(uint64_t& bytes, uint64_t& active_activities, uint64_t& local_frees, uint64_t& remote_frees) {
         bytes = 0;
         active_activities = 0;
+        local_frees = 0;
+        remote_frees = 0;
         for ( auto && entry : Activity::memPools ) {
             bytes += entry.pool->getBytesMemUsed();
             active_activities += entry.pool->getUndeletedEntries();
+            uint64_t local, remote;
+            entry.pool->getFreeCounts(local, remote);
+            local_frees += local;
+            remote_frees += remote;
+        }
+    }
+
+    /** Returns the bytes of memory pool arenas currently in memory,
+     * the peak of that value summed over the pools, and the bytes
+     * held by live Activities.  The difference between arena_bytes
+     * and live_bytes is free or fragmented. */
+    static void getMemPoolArenaUsage(uint64_t& arena_bytes, uint64_t& peak_bytes, uint64_t& live_bytes) {
+        arena_bytes = 0;
+        peak_bytes = 0;
+        live_bytes = 0;
+        for ( auto && entry : Activity::memPools ) {
+            arena_bytes += entry.pool->getArenaBytes();
+            peak_bytes += entry.pool->getPeakArenaBytes();
+            live_bytes += entry.pool->getUndeletedEntries() * entry.pool->getElementSize();
+        }
+    }
+
+    /** Print usage and fragmentation of each memory pool */
+    static void printMemPoolStats(const std::string& header, Output &out) {
+        for ( auto && entry : Activity::memPools ) {
+            uint64_t arena_bytes = entry.pool->getArenaBytes();
+            uint64_t live = entry.pool->getUndeletedEntries();
+            uint64_t live_bytes = live * entry.pool->getElementSize();
+            double frag = arena_bytes ? 100.0 * (1.0 - (double)live_bytes / arena_bytes) : 0.0;
+            out.output("%sMemPool %zu: element size %zu B, arenas %" PRIu64 " B (peak %" PRIu64 " B), live %" PRIu64 " activities (%" PRIu64 " B), %.1f%% free\n",
+                       header.c_str(), entry.pool->getId(), entry.pool->getElementSize(),
+                       arena_bytes, entry.pool->getPeakArenaBytes(), live, live_bytes, frag);
         }
     }
 
@@ -309,9 +351,13 @@ public:
             size_t elemSize = entry.pool->getElementSize();
             size_t nelem = arenaSize / elemSize;
             for ( auto iter = arenas.begin(); iter != arenas.end(); ++iter ) {
+                // Released arenas hold no activities
+                if ( !entry.pool->isArenaResident(*iter) ) continue;
                 for ( size_t j = 0; j < nelem; j++ ) {
                     PoolData_t* ptr = (PoolData_t*)((*iter) + (elemSize*j));
-                    if ( *ptr != nullptr ) {
+                    // Elements that were never allocated are either
+                    // zero or, in debug builds, poisoned
+                    if ( *ptr != nullptr && *(uint8_t*)ptr != Core::MemPool::POISON ) {
                         Activity* act = (Activity*)(ptr + 1);
                         if ( act->delivery_time <= before ) {
                             act->print(header, out);
@@ -372,6 +418,33 @@ private:
     };
     static std::mutex poolMutex;
     static std::vector<PoolInfo_t> memPools;
+    /* MemPool::ArenaFlags for new pools */
+    static uint32_t memPoolFlags;
+    /* Completely free arenas a pool keeps with MemPool::RECLAIM */
+    static size_t memPoolReclaimReserve;
+
+    /* Per-thread lookup tables for the memory pools */
+    struct PoolCache_t {
+        /* Magazine for this thread's pool of each size class
+         * (allocation size in units of PoolData_t) */
+        std::vector<Core::MemPool::Magazine*> bySize;
+        /* Magazine for each pool this thread has used, indexed by
+         * pool id */
+        std::vector<std::unique_ptr<Core::MemPool::Magazine>> byPool;
+    };
+    static thread_local PoolCache_t poolCache;
+
+    /** Returns this thread's magazine for pool */
+    static Core::MemPool::Magazine& getPoolMagazine(Core::MemPool* pool) {
+        std::vector<std::unique_ptr<Core::MemPool::Magazine>>& by_pool = poolCache.byPool;
+        size_t id = pool->getId();
+        if ( LIKELY(id < by_pool.size() && by_pool[id]) ) return *by_pool[id];
+        return newPoolMagazine(pool);
+    }
+
+    /* Slow paths, defined in event.cc */
+    static Core::MemPool::Magazine& newPoolMagazine(Core::MemPool* pool);
+    static Core::MemPool::Magazine& getSizeMagazine(size_t size_class);
 #endif
 };
 
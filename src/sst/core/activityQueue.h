@@ -13,6 +13,8 @@
 #ifndef SST_CORE_ACTIVITYQUEUE_H
 #define SST_CORE_ACTIVITYQUEUE_H
 
+#include <vector>
+
 #include "sst/core/activity.h"
 
 namespace SST {
@@ -34,6 +36,22 @@ public:
     virtual void insert(Activity* activity) = 0;
     /** Returns the next activity */
     virtual Activity* front() = 0;
+    /** Remove the activities that share the delivery time and priority
+     * of the next activity and append them to batch, which must be
+     * empty.  The batch is ordered so that the next activity to be
+     * delivered is at the back.  Queues that support batching add any
+     * activity inserted with the same time and priority to the batch
+     * (in order) while it is non-empty.  The default implementation
+     * returns a batch of one. */
+    virtual void popBatch(std::vector<Activity*>& batch) { batch.push_back(pop()); }
+    /** True if popBatch() can return more than one activity.  Callers
+     * should use pop() on queues that don't. */
+    virtual bool supportsBatch() const { return false; }
+    /** Insert all the activities in batch, in order.  The default
+     * implementation inserts them one at a time. */
+    virtual void insertBatch(const std::vector<Activity*>& batch) {
+        for ( auto* act : batch ) insert(act);
+    }
 
 private:
 
@@ -116,31 +116,15 @@ BaseComponent::pushValidParams(Params& params, const std::string& type)
 
 
 TimeConverter* BaseComponent::registerClock( const std::string& freq, Clock::HandlerBase* handler, bool regAll) {
-    TimeConverter* tc = getSimulation()->registerClock(freq, handler, CLOCKPRIORITY);
-
-    // if regAll is true set tc as the default for the component and
-    // for all the links
-    if ( regAll ) {
-        setDefaultTimeBaseForLinks(tc);
-        my_info->defaultTimeBase = tc;
-    }
-    return tc;
+    return registerClock(getSimulation()->getTimeLord()->getTimeConverter(freq), handler, regAll);
 }
 
 TimeConverter* BaseComponent::registerClock( const UnitAlgebra& freq, Clock::HandlerBase* handler, bool regAll) {
-    TimeConverter* tc = getSimulation()->registerClock(freq, handler, CLOCKPRIORITY);
-
-    // if regAll is true set tc as the default for the component and
-    // for all the links
-    if ( regAll ) {
-        setDefaultTimeBaseForLinks(tc);
-        my_info->defaultTimeBase = tc;
-    }
-    return tc;
+    return registerClock(getSimulation()->getTimeLord()->getTimeConverter(freq), handler, regAll);
 }
 
 TimeConverter* BaseComponent::registerClock( TimeConverter* tc, Clock::HandlerBase* handler, bool regAll) {
-    TimeConverter* tcRet = getSimulation()->registerClock(tc, handler, CLOCKPRIORITY);
+    TimeConverter* tcRet = getSimulation()->registerClock(tc, my_info->trackClock(tc, CLOCKPRIORITY, handler), CLOCKPRIORITY);
 
     // if regAll is true set tc as the default for the component and
     // for all the links
@@ -152,7 +136,7 @@ TimeConverter* BaseComponent::registerClock( TimeConverter* tc, Clock::HandlerBa
 }
 
 Cycle_t BaseComponent::reregisterClock( TimeConverter* freq, Clock::HandlerBase* handler) {
-    return getSimulation()->reregisterClock(freq, handler, CLOCKPRIORITY);
+    return getSimulation()->reregisterClock(freq, my_info->findClock(freq, CLOCKPRIORITY, handler), CLOCKPRIORITY);
 }
 
 Cycle_t BaseComponent::getNextClockCycle( TimeConverter* freq ) {
@@ -160,15 +144,26 @@ Cycle_t BaseComponent::getNextClockCycle( TimeConverter* freq ) {
 }
 
 void BaseComponent::unregisterClock(TimeConverter *tc, Clock::HandlerBase* handler) {
-    getSimulation()->unregisterClock(tc, handler, CLOCKPRIORITY);
+    getSimulation()->unregisterClock(tc, my_info->findClock(tc, CLOCKPRIORITY, handler), CLOCKPRIORITY);
 }
 
 TimeConverter* BaseComponent::registerOneShot( const std::string& timeDelay, OneShot::HandlerBase* handler) {
-    return getSimulation()->registerOneShot(timeDelay, handler, ONESHOTPRIORITY);
+    TimeConverter* tc = getSimulation()->registerOneShot(timeDelay, handler, ONESHOTPRIORITY);
+    trackOneShot(tc);
+    return tc;
 }
 
 TimeConverter* BaseComponent::registerOneShot( const UnitAlgebra& timeDelay, OneShot::HandlerBase* handler) {
-    return getSimulation()->registerOneShot(timeDelay, handler, ONESHOTPRIORITY);
+    TimeConverter* tc = getSimulation()->registerOneShot(timeDelay, handler, ONESHOTPRIORITY);
+    trackOneShot(tc);
+    return tc;
+}
+
+void BaseComponent::trackOneShot(TimeConverter* tc) {
+    // The Component can't move to another thread until the OneShot
+    // has fired
+    SimTime_t end = getSimulation()->getCurrentSimCycle() + tc->getFactor();
+    if ( end > my_info->oneShotEnd ) my_info->oneShotEnd = end;
 }
 
 TimeConverter* BaseComponent::registerTimeBase( const std::string& base, bool regAll) {
@@ -300,7 +295,7 @@ BaseComponent::configureLink(const std::string& name, TimeConverter* time_base,
         if ( handler == nullptr ) {
             tmp->setPolling();
         }
-        tmp->setFunctor(handler);
+        tmp->setFunctor(my_info->trackHandler(handler));
         if ( nullptr != time_base ) tmp->setDefaultTimeBase(time_base);
         else tmp->setDefaultTimeBase(my_info->defaultTimeBase);
         tmp->setAsConfigured();
@@ -638,6 +638,7 @@ private:
 
     void addSelfLink(const std::string& name);
     Link* getLinkFromParentSharedPort(const std::string& port);
+    void trackOneShot(TimeConverter* tc);
 
     using CreateFxn = std::function<StatisticBase*(const std::string&,
                             BaseComponent*,const std::string&, const std::string&, SST::Params&)>;
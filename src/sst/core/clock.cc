@@ -51,17 +51,19 @@ bool Clock::unregisterHandler( Clock::HandlerBase* handler, bool& empty )
 {
 
     StaticHandlerMap_t::iterator iter = staticHandlerMap.begin();
+    bool found = false;
 
     for ( ; iter != staticHandlerMap.end(); iter++ ) {
         if ( *iter == handler ) {
             staticHandlerMap.erase( iter );
+            found = true;
             break;
         }
     }
 
     empty = staticHandlerMap.empty();
 
-    return 0;
+    return found;
 }
 
 Cycle_t
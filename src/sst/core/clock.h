@@ -111,12 +111,15 @@ public:
 
     /** Add a handler to be called on this clock's tick */
     bool registerHandler( Clock::HandlerBase* handler );
-    /** Remove a handler from the list of handlers to be called on the clock tick */
+    /** Remove a handler from the list of handlers to be called on the clock tick
+     * @return true if the handler was on the list */
     bool unregisterHandler( Clock::HandlerBase* handler, bool& empty );
 
     void print(const std::string& header, Output &out) const override;
 
 private:
+    friend class ThreadLoadBalancer;
+
 /*     typedef std::list<Clock::HandlerBase*> HandlerMap_t; */
     typedef std::vector<Clock::HandlerBase*> StaticHandlerMap_t;
 
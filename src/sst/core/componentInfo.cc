@@ -14,8 +14,10 @@
 // #include "sst/core/serialization.h"
 
 #include "sst/core/componentInfo.h"
+#include "sst/core/baseComponent.h"
 #include "sst/core/configGraph.h"
 #include "sst/core/linkMap.h"
+#include "sst/core/threadLoadBalancer.h"
 
 namespace SST {
 
@@ -33,7 +35,9 @@ ComponentInfo::ComponentInfo(ComponentId_t id, const std::string& name) :
     subIDIndex(1),
     slot_name(""),
     slot_num(-1),
-    share_flags(0)
+    share_flags(0),
+    load(0),
+    oneShotEnd(0)
 {
 }
 
@@ -72,7 +76,9 @@ ComponentInfo::ComponentInfo(ComponentId_t id, ComponentInfo* parent_info, const
     subIDIndex(1),
     slot_name(slot_name),
     slot_num(slot_num),
-    share_flags(share_flags)
+    share_flags(share_flags),
+    load(0),
+    oneShotEnd(0)
 {
     /*params.insert(params_in.getParams());*/
 }
@@ -93,7 +99,9 @@ ComponentInfo::ComponentInfo(ConfigComponent *ccomp, const std::string& name, Co
     subIDIndex(1),
     slot_name(ccomp->name),
     slot_num(ccomp->slot_num),
-    share_flags(0)
+    share_flags(0),
+    load(0),
+    oneShotEnd(0)
 {
     // printf("ComponentInfo(ConfigComponent): id = %llx\n",ccomp->id);
 
@@ -134,7 +142,10 @@ ComponentInfo::ComponentInfo(ComponentInfo &&o) :
     subIDIndex(o.subIDIndex),
     slot_name(o.slot_name),
     slot_num(o.slot_num),
-    share_flags(o.share_flags)
+    share_flags(o.share_flags),
+    clocks(std::move(o.clocks)),
+    load(o.load),
+    oneShotEnd(o.oneShotEnd)
 {
     o.parent_info = nullptr;
     o.link_map = nullptr;
@@ -230,6 +241,63 @@ ComponentInfo* ComponentInfo::findSubComponent(const std::string& slot, int slot
 }
 
 
+Clock::HandlerBase* ComponentInfo::trackClock(TimeConverter* tc, int priority, Clock::HandlerBase* handler)
+{
+    if ( !ThreadLoadBalancer::isTracking() ) return handler;
+
+    // Handlers that are registered again keep their wrapper
+    for ( auto& c : clocks ) {
+        if ( c.handler == handler ) {
+            c.tc = tc;
+            c.priority = priority;
+            return c.registered;
+        }
+    }
+
+    ComponentInfo* real_comp = this;
+    while ( real_comp->parent_info != nullptr ) real_comp = real_comp->parent_info;
+
+    Clock::HandlerBase* registered = new ThreadLoadBalancer::TimedClockHandler(handler, &real_comp->load);
+    clocks.push_back({tc, priority, handler, registered});
+    return registered;
+}
+
+Clock::HandlerBase* ComponentInfo::findClock(TimeConverter* tc, int priority, Clock::HandlerBase* handler)
+{
+    for ( auto& c : clocks ) {
+        if ( c.handler == handler ) {
+            c.tc = tc;
+            c.priority = priority;
+            return c.registered;
+        }
+    }
+    return handler;
+}
+
+Event::HandlerBase* ComponentInfo::trackHandler(Event::HandlerBase* handler)
+{
+    if ( !ThreadLoadBalancer::isTracking() || handler == nullptr ) return handler;
+
+    ComponentInfo* real_comp = this;
+    while ( real_comp->parent_info != nullptr ) real_comp = real_comp->parent_info;
+
+    return new ThreadLoadBalancer::TimedEventHandler(handler, &real_comp->load);
+}
+
+void ComponentInfo::setSimulation(Simulation* sim)
+{
+    if ( nullptr != component ) component->sim = sim;
+    if ( nullptr != link_map ) {
+        for ( auto & i : link_map->getLinkMap() ) {
+            i.second->sim = sim;
+        }
+    }
+    for ( auto &s : subComponents ) {
+        s.second.setSimulation(sim);
+    }
+}
+
+
 std::vector<LinkId_t> ComponentInfo::getAllLinkIds() const
 {
     std::vector<LinkId_t> res;
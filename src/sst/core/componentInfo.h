@@ -13,6 +13,8 @@
 #define SST_CORE_COMPONENTINFO_H
 
 #include "sst/core/sst_types.h"
+#include "sst/core/clock.h"
+#include "sst/core/event.h"
 #include "sst/core/params.h"
 
 #include <unordered_set>
@@ -27,6 +29,7 @@ class BaseComponent;
 
 class ConfigComponent;
 class ComponentInfoMap;
+class Simulation;
 class TimeConverter;
 
 namespace Statistics {
@@ -57,6 +60,7 @@ private:
     friend class Simulation;
     friend class BaseComponent;
     friend class ComponentInfoMap;
+    friend class ThreadLoadBalancer;
 
 
     /**
@@ -142,6 +146,46 @@ private:
     uint64_t share_flags;
 
 
+    // Variables only used while the ThreadLoadBalancer is measuring
+    // load
+
+    /**
+       A clock handler registered through the (Sub)Component API.
+       Kept so the handler can be found on the Clock when the
+       Component moves to another thread.
+     */
+    struct ClockRegistration {
+        TimeConverter* tc;
+        int priority;
+        Clock::HandlerBase* handler;     /*!< Handler passed in by the (Sub)Component */
+        Clock::HandlerBase* registered;  /*!< Handler registered with the Clock */
+    };
+
+    std::vector<ClockRegistration> clocks;
+
+    /**
+       Nanoseconds spent in the handlers of this Component and its
+       SubComponents since the last rebalance.  Only used for
+       Components.
+     */
+    uint64_t load;
+
+    /**
+       Latest time at which a OneShot registered by this
+       (Sub)Component fires.
+     */
+    SimTime_t oneShotEnd;
+
+    /** Returns the handler to register with the Clock for handler */
+    Clock::HandlerBase* trackClock(TimeConverter* tc, int priority, Clock::HandlerBase* handler);
+    /** Returns the handler registered with the Clock for handler */
+    Clock::HandlerBase* findClock(TimeConverter* tc, int priority, Clock::HandlerBase* handler);
+    /** Returns the handler to give the Link for handler */
+    Event::HandlerBase* trackHandler(Event::HandlerBase* handler);
+    /** Point the (Sub)Components and their Links at sim */
+    void setSimulation(Simulation* sim);
+
+
     bool sharesPorts() {
         return (share_flags & SHARE_PORTS) != 0;
     }
@@ -268,6 +312,10 @@ public:
         dataByID.insert(info);
     }
 
+    void erase(ComponentInfo* info) {
+        dataByID.erase(info);
+    }
+
     ComponentInfo* getByID(const ComponentId_t key) const {
         ComponentInfo infoKey(COMPONENT_ID_MASK(key), "");
         auto value = dataByID.find(&infoKey);
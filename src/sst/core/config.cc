@@ -35,6 +35,7 @@ REENABLE_WARNING
 
 #include "sst/core/build_info.h"
 #include "sst/core/output.h"
+#include "sst/core/threadAffinity.h"
 //#include "sst/core/sdl.h"
 
 using namespace std;
@@ -57,6 +58,9 @@ Config::Config(RankInfo rankInfo)
     heartbeatPeriod = "N";
     partitioner = "sst.linear";
     timeVortex  = "sst.timevortex.priority_queue";
+    threadSync  = "simple";
+    rankSync    = "skip";
+    rebalancePeriod = "";
     dump_component_graph_file = "";
 
     char* wd_buf = (char*) malloc( sizeof(char) * PATH_MAX );
@@ -77,10 +81,17 @@ Config::Config(RankInfo rankInfo)
     output_core_prefix = "@x SST Core: ";
     print_timing = false;
     print_env = false;
+    barrier_spin = -1;
+    thread_affinity = "none";
 
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     event_dump_file = "";
 #endif
+#ifdef USE_MEMPOOL
+    mempool_hugepages = "none";
+    mempool_numa = false;
+    mempool_reclaim = -1;
+#endif
 
     // Some config items can be initialized from either the command line or
     // the config file. The command line has precedence. We need to initialize
@@ -133,7 +144,10 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_ARGOPT("heartbeat-period",  "PERIOD",       "set time for heartbeats to be published (these are approximate timings, published by the core, to update on progress), default is every 10000 simulated seconds", &Config::setHeartbeat),
     DEF_ARGOPT("timebase",          "TIMEBASE",     "sets the base time step of the simulation (default: 1ps)", &Config::setTimebase),
     DEF_ARGOPT("partitioner",       "PARTITIONER",  "select the partitioner to be used. <lib.partitionerName>", &Config::setPartitioner),
-    DEF_ARGOPT("timeVortex ",       "MODULE",       "select TimeVortex implementation <lib.timevortex>", &Config::setTimeVortex),
+    DEF_ARGOPT("timeVortex",        "MODULE",       "select TimeVortex implementation <lib.timevortex> (e.g. sst.timevortex.priority_queue, sst.timevortex.calendar_queue, sst.timevortex.ladder_queue, sst.timevortex.bucket_queue)", &Config::setTimeVortex),
+    DEF_ARGOPT("thread-sync",       "MODE",         "select how threads synchronize [ simple | pairwise ] (default: simple).  simple syncs all threads at the smallest cross-thread latency, pairwise only waits on the threads each thread has links to", &Config::setThreadSync),
+    DEF_ARGOPT("rank-sync",         "MODE",         "select how ranks synchronize [ skip | pipelined | shared ] (default: skip).  pipelined syncs twice as often but overlaps each exchange with the simulation up to the next sync.  shared exchanges events between ranks on the same node through shared memory.  Only used with one thread per rank", &Config::setRankSync),
+    DEF_ARGOPT("rebalance-period",  "PERIOD",       "move components between the threads of a rank to even out the time spent in their handlers, checking every PERIOD of simulated time (default: never).  Requires --thread-sync=simple; components with links to other ranks or pending OneShots are not moved", &Config::setRebalancePeriod),
     DEF_ARGOPT("output-directory",  "DIR",          "directory into which all SST output files should reside", &Config::setOutputDir),
     DEF_ARGOPT("output-config",     "FILE",         "file to write SST configuration (in Python format)", &Config::setWriteConfig),
     DEF_ARGOPT("output-dot",        "FILE",         "file to write SST configuration graph (in GraphViz format)", &Config::setWriteDot),
@@ -143,9 +157,14 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_ARGOPT("output-prefix-core","STR",          "set the SST::Output prefix for the core", &Config::setOutputPrefix),
 #ifdef USE_MEMPOOL
     DEF_ARGOPT("output-undeleted-events",   "FILE", "file to write information about all undeleted events at the end of simulation (STDOUT and STDERR can be used to output to console)", &Config::setWriteUndeleted),
+    DEF_ARGOPT("mempool-hugepages", "MODE",         "back event memory pools with huge pages [none | transparent | explicit] (default: none).  explicit falls back to transparent if no huge pages are reserved", &Config::setMemPoolHugePages),
+    DEF_FLAGOPT("mempool-numa",             0,      "place event memory pools on the NUMA node of the thread that allocates them", &Config::enableMemPoolNUMA),
+    DEF_ARGOPT("mempool-reclaim",   "NUM",          "return completely free event memory pool arenas to the OS once a pool has more than NUM of them (default: never)", &Config::setMemPoolReclaim),
 #endif
     DEF_ARGOPT("model-options",     "STR",          "provide options to the python configuration script", &Config::setModelOptions),
     DEF_ARGOPT_SHORT("num_threads", 'n',   "NUM",   "number of parallel threads to use per rank", &Config::setNumThreads),
+    DEF_ARGOPT("barrier-spin",      "NUM",          "most times a thread spins at a barrier between threads before it sleeps.  The actual count adapts to recent wait times (default: 4096)", &Config::setBarrierSpin),
+    DEF_ARGOPT("thread-affinity",   "MODE",         "pin each thread to a cpu [ none | compact | scatter | CPULIST ] (default: none).  compact fills cores sharing a cache first and places threads with many links between them close together, scatter spreads threads across sockets, CPULIST (e.g. 0-3,8) gives the cpu of each thread in order", &Config::setThreadAffinity),
     {{nullptr, 0, nullptr, 0}, nullptr, nullptr, nullptr, nullptr}
 };
 static const size_t nLongOpts = (sizeof(sstOptions) / sizeof(sstLongOpts_s)) -1;
@@ -453,6 +472,25 @@ bool Config::setTimeVortex(const std::string& arg) {
     return true;
 }
 
+bool Config::setThreadSync(const std::string& arg) {
+    if ( arg != "simple" && arg != "pairwise" ) {
+        fprintf(stderr, "Unknown thread sync mode: %s.  Must be one of simple or pairwise\n", arg.c_str());
+        return false;
+    }
+    threadSync = arg;
+    return true;
+}
+
+bool Config::setRankSync(const std::string& arg) {
+    if ( arg != "skip" && arg != "pipelined" && arg != "shared" ) {
+        fprintf(stderr, "Unknown rank sync mode: %s.  Must be one of skip, pipelined or shared\n", arg.c_str());
+        return false;
+    }
+    rankSync = arg;
+    return true;
+}
+
+bool Config::setRebalancePeriod(const std::string& arg) { rebalancePeriod = arg; return true; }
 bool Config::setOutputDir(const std::string& arg) { output_directory = arg ;  return true; }
 bool Config::setWriteConfig(const std::string& arg) { output_config_graph = arg;  return true; }
 bool Config::setWriteDot(const std::string& arg) { output_dot = arg; return true; }
@@ -462,6 +500,27 @@ bool Config::setWritePartition(const std::string& arg) { dump_component_graph_fi
 bool Config::setOutputPrefix(const std::string& arg) { output_core_prefix = arg; return true; }
 #ifdef USE_MEMPOOL
 bool Config::setWriteUndeleted(const std::string& arg) { event_dump_file = arg; return true; }
+
+bool Config::setMemPoolHugePages(const std::string& arg) {
+    if ( arg != "none" && arg != "transparent" && arg != "explicit" ) {
+        fprintf(stderr, "Unknown mempool huge page mode: %s.  Must be one of none, transparent or explicit\n", arg.c_str());
+        return false;
+    }
+    mempool_hugepages = arg;
+    return true;
+}
+
+bool Config::setMemPoolReclaim(const std::string& arg) {
+    errno = E_OK;
+    char* end;
+    long long val = strtoll(arg.c_str(), &end, 0);
+    if ( errno == E_OK && *end == '\0' && val >= 0 ) {
+        mempool_reclaim = val;
+        return true;
+    }
+    fprintf(stderr, "Failed to parse [%s] as number of arenas\n", arg.c_str());
+    return false;
+}
 #endif
 
 bool Config::setModelOptions(const std::string& arg) {
@@ -496,6 +555,28 @@ bool Config::setNumThreads(const std::string& arg) {
     return false;
 }
 
+bool Config::setBarrierSpin(const std::string& arg) {
+    errno = E_OK;
+    char* end;
+    long long val = strtoll(arg.c_str(), &end, 0);
+    if ( errno == E_OK && *end == '\0' && val >= 0 && val <= UINT32_MAX ) {
+        barrier_spin = val;
+        return true;
+    }
+    fprintf(stderr, "Failed to parse [%s] as number of spins\n", arg.c_str());
+    return false;
+}
+
+bool Config::setThreadAffinity(const std::string& arg) {
+    std::vector<int> cpus;
+    if ( arg != "none" && arg != "compact" && arg != "scatter" && !Core::parseCpuList(arg, cpus) ) {
+        fprintf(stderr, "Unknown thread affinity: %s.  Must be one of none, compact, scatter or a list of cpus\n", arg.c_str());
+        return false;
+    }
+    thread_affinity = arg;
+    return true;
+}
+
 
 
 /* Getters */
@@ -61,6 +61,9 @@ public:
     std::string     timeBase;           /*!< Timebase of simulation */
     std::string     partitioner;        /*!< Partitioner to use */
     std::string     timeVortex;         /*!< TimeVortex implementation to use */
+    std::string     threadSync;         /*!< Thread synchronization to use */
+    std::string     rankSync;           /*!< Rank synchronization to use */
+    std::string     rebalancePeriod;    /*!< How often to move components between threads to balance load (empty for never) */
     std::string     output_config_graph;  /*!< File to dump configuration graph */
     std::string     output_dot;         /*!< File to dump dot output */
     std::string     output_xml;         /*!< File to dump XML output */
@@ -76,9 +79,14 @@ public:
     bool            enable_sig_handling; /*!< Enable signal handling */
     bool            print_timing;       /*!< Print SST timing information */
     bool            print_env;          /*!< Print SST environment */
+    int64_t         barrier_spin;       /*!< Most spins before a thread sleeps at a barrier (-1 for the default) */
+    std::string     thread_affinity;    /*!< How to pin threads to cpus (none, compact, scatter or a cpu list) */
 
 #ifdef USE_MEMPOOL
     std::string     event_dump_file;    /*!< File to dump undeleted events to */
+    std::string     mempool_hugepages;  /*!< Huge page mode for memory pool arenas */
+    bool            mempool_numa;       /*!< Place memory pool arenas on the allocating thread's NUMA node */
+    int64_t         mempool_reclaim;    /*!< Free memory pool arenas kept before releasing them (-1 to never release) */
 #endif
 
 
@@ -105,6 +113,9 @@ public:
     bool setTimebase(const std::string& arg);
     bool setPartitioner(const std::string& arg);
     bool setTimeVortex(const std::string& arg);
+    bool setThreadSync(const std::string& arg);
+    bool setRankSync(const std::string& arg);
+    bool setRebalancePeriod(const std::string& arg);
     bool setOutputDir(const std::string& arg);
     bool setWriteConfig(const std::string& arg);
     bool setWriteDot(const std::string& arg);
@@ -114,9 +125,14 @@ public:
     bool setOutputPrefix(const std::string& arg);
 #ifdef USE_MEMPOOL
     bool setWriteUndeleted(const std::string& arg);
+    bool setMemPoolHugePages(const std::string& arg);
+    bool enableMemPoolNUMA()    { mempool_numa = true; return true; }
+    bool setMemPoolReclaim(const std::string& arg);
 #endif
     bool setModelOptions(const std::string& arg);
     bool setNumThreads(const std::string& arg);
+    bool setBarrierSpin(const std::string& arg);
+    bool setThreadAffinity(const std::string& arg);
 
 
     Simulation::Mode_t getRunMode() { return runMode; }
@@ -744,6 +744,16 @@ ConfigGraph::setLinkNoCut(const std::string& link_name)
     link.no_cut = true;
 }
 
+void
+ConfigGraph::setLinkCoalesce(const std::string& link_name)
+{
+    // If link doesn't exist, return
+    if ( link_names.find(link_name) == link_names.end() ) return;
+
+    ConfigLink &link = links[link_names[link_name]];
+    link.coalesce = true;
+}
+
 
 
 bool ConfigGraph::containsComponent(ComponentId_t id) const {
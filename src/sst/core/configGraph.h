@@ -56,6 +56,7 @@ public:
     std::string      latency_str[2];/*!< Temp string holding latency */
     int              current_ref;   /*!< Number of components currently referring to this Link */
     bool             no_cut;        /*!< If set to true, partitioner will not make a cut through this Link */
+    bool             coalesce;      /*!< If set to true, events sent during a time step for the same time are merged (see Event::merge()) */
 
     // inline const std::string& key() const { return name; }
     inline LinkId_t key() const { return id; }
@@ -90,6 +91,7 @@ public:
         ser & latency[0];
         ser & latency[1];
         ser & current_ref;
+        ser & coalesce;
     }
 
     ImplementSerializable(SST::ConfigLink)
@@ -98,7 +100,8 @@ private:
     friend class ConfigGraph;
     ConfigLink(LinkId_t id) :
         id(id),
-        no_cut(false)
+        no_cut(false),
+        coalesce(false)
     {
         current_ref = 0;
 
@@ -109,7 +112,8 @@ private:
 
     ConfigLink(LinkId_t id, const std::string& n) :
         id(id),
-        no_cut(false)
+        no_cut(false),
+        coalesce(false)
     {
         current_ref = 0;
         name = n;
@@ -386,6 +390,9 @@ public:
     /** Set a Link to be no-cut */
     void setLinkNoCut(const std::string& link_name);
 
+    /** Set a Link to merge events sent for the same time */
+    void setLinkCoalesce(const std::string& link_name);
+
     /** Perform any post-creation cleanup processes */
     void postCreationCleanup();
 
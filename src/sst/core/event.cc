@@ -54,6 +54,36 @@ void NullEvent::execute(void)
 #ifdef USE_MEMPOOL
 std::mutex Activity::poolMutex;
 std::vector<Activity::PoolInfo_t> Activity::memPools;
+uint32_t Activity::memPoolFlags = 0;
+size_t Activity::memPoolReclaimReserve = 0;
+thread_local Activity::PoolCache_t Activity::poolCache;
+
+Core::MemPool::Magazine& Activity::newPoolMagazine(Core::MemPool* pool)
+{
+    std::vector<std::unique_ptr<Core::MemPool::Magazine>>& by_pool = poolCache.byPool;
+    size_t id = pool->getId();
+    if ( id >= by_pool.size() ) by_pool.resize(id + 1);
+    by_pool[id].reset(new Core::MemPool::Magazine(pool));
+    return *by_pool[id];
+}
+
+Core::MemPool::Magazine& Activity::getSizeMagazine(size_t size_class)
+{
+    /* Each thread has its own pool for each size class, so a miss in
+     * the table means this thread needs a new pool */
+    size_t size = size_class * sizeof(PoolData_t);
+    Core::MemPool* pool = new Core::MemPool(size + sizeof(PoolData_t), (2<<20), memPoolFlags, memPoolReclaimReserve);
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        memPools.emplace_back(std::this_thread::get_id(), size, pool);
+    }
+
+    Core::MemPool::Magazine& mag = newPoolMagazine(pool);
+    std::vector<Core::MemPool::Magazine*>& by_size = poolCache.bySize;
+    if ( size_class >= by_size.size() ) by_size.resize(size_class + 1, nullptr);
+    by_size[size_class] = &mag;
+    return mag;
+}
 #endif
 
 
@@ -52,6 +52,14 @@ public:
     /** Clones the event in for the case of a broadcast */
     virtual Event* clone();
 
+    /** Merge a later event into this one.  Only called on Links set to
+     * coalesce events, when next is sent on the same Link during the
+     * same time step, to be delivered at the same time and priority as
+     * this event.  Return true if next was merged, in which case the
+     * core deletes it and the handler is only called once for both,
+     * or false to deliver both.  By default events are not merged. */
+    virtual bool merge(Event* UNUSED(next)) { return false; }
+
     /** Sets the link id used for delivery.  For use by SST Core only */
     inline void setDeliveryLink(LinkId_t id, Link *link) {
 #ifdef SST_ENFORCE_EVENT_ORDERING
@@ -34,14 +34,18 @@ Exit::Exit( int num_threads, TimeConverter* period, bool single_rank ) :
 //     m_functor( new EventHandler<Exit,bool,Event*> (this,&Exit::handler ) ),
     num_threads(num_threads),
     m_refCount( 0 ),
+    // Not known until the first sync; nonzero so nothing ends before it
+    global_count( 1 ),
     m_period( period ),
     end_time(0),
     single_rank(single_rank)
 {
     setPriority(EXITPRIORITY);
     m_thread_counts = new unsigned int[num_threads];
+    m_thread_end_times = new SimTime_t[num_threads];
     for ( int i = 0; i < num_threads; i++ ) {
         m_thread_counts[i] = 0;
+        m_thread_end_times[i] = 0;
     }
     // if (!single_rank) sim->insertActivity( period->getFactor(), this );
 }
@@ -118,6 +122,7 @@ bool Exit::refDec( ComponentId_t id, uint32_t thread )
         // trace.getOutput().output(CALL_INFO,"end_time_new = %llu\n",end_time_new);
         // trace.getOutput().output(CALL_INFO,"end_time = %llu\n",end_time);
         if ( end_time_new > end_time ) end_time = end_time_new;
+        m_thread_end_times[thread] = end_time_new;
         if ( Simulation::getSimulation()->isIndependentThread() ) {
             // Need to exit just this thread, so we'll need to use a
             // StopAction
@@ -129,10 +134,27 @@ bool Exit::refDec( ComponentId_t id, uint32_t thread )
     return false;
 }
 
+void Exit::moveComponent( ComponentId_t id, uint32_t from_thread, uint32_t to_thread )
+{
+    std::lock_guard<Spinlock> lock(slock);
+    if ( m_idSet.find( id ) == m_idSet.end() ) return;
+
+    --m_thread_counts[from_thread];
+    ++m_thread_counts[to_thread];
+}
+
 unsigned int Exit::getRefCount() {
     return m_refCount;
 }
 
+SimTime_t Exit::getThreadEndTime( uint32_t thread )
+{
+    // The count is only changed by the thread itself, or while every
+    // thread is stopped, so no lock is needed
+    if ( m_thread_counts[thread] > 0 ) return MAX_SIMTIME_T;
+    return m_thread_end_times[thread];
+}
+
 
 void
 Exit::execute()
@@ -144,6 +166,12 @@ Exit::execute()
 
 }
 
+void Exit::setGlobalState(unsigned int count, SimTime_t end)
+{
+    global_count = count;
+    if ( !count ) end_time = end;
+}
+
 // bool Exit::handler( Event* e )
 void Exit::check()
 {
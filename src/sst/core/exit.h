@@ -54,12 +54,22 @@ public:
     bool refInc( ComponentId_t, uint32_t thread );
     /** Decrement Reference Count for a given Component ID */
     bool refDec( ComponentId_t, uint32_t thread );
+    /** Move the reference held by a Component to another thread */
+    void moveComponent( ComponentId_t id, uint32_t from_thread, uint32_t to_thread );
 
     unsigned int getRefCount();
     SimTime_t getEndTime() { return end_time; }
+    /** Time at which thread last dropped its references, or
+     * MAX_SIMTIME_T while it still holds some.  Only called from
+     * thread itself. */
+    SimTime_t getThreadEndTime( uint32_t thread );
 
     void execute(void) override;
     void check();
+    /** Take the result of a reduction done as part of a rank sync in
+     * place of check().  count is the number of ranks that still hold
+     * references and end the latest end time of all ranks. */
+    void setGlobalState(unsigned int count, SimTime_t end);
 
     void print(const std::string& header, Output &out) const override {
         out.output("%s Exit Action to be delivered at %" PRIu64 " with priority %d\n",
@@ -81,6 +91,7 @@ private:
     int num_threads;
     unsigned int    m_refCount;
     unsigned int*   m_thread_counts;
+    SimTime_t*      m_thread_end_times;
     unsigned int    global_count;
     TimeConverter*  m_period;
     std::unordered_set<ComponentId_t> m_idSet;
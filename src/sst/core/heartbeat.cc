@@ -69,10 +69,15 @@ void SimulatorHeartbeat::execute( void )
 
     uint64_t mempool_size = 0;
     uint64_t active_activities = 0;
+    uint64_t local_frees = 0, remote_frees = 0;
+    uint64_t arena_bytes = 0, peak_arena_bytes = 0, live_bytes = 0;
 #ifdef USE_MEMPOOL
-    Activity::getMemPoolUsage(mempool_size, active_activities);
+    Activity::getMemPoolUsage(mempool_size, active_activities, local_frees, remote_frees);
+    Activity::getMemPoolArenaUsage(arena_bytes, peak_arena_bytes, live_bytes);
 #endif
     uint64_t max_mempool_size, global_mempool_size, global_active_activities;
+    uint64_t global_local_frees, global_remote_frees;
+    uint64_t global_arena_bytes, global_peak_arena_bytes, global_live_bytes;
 
 #ifdef SST_CONFIG_HAVE_MPI
     uint64_t local_sync_data_size = Simulation::getSimulation()->getSyncQueueDataSize();
@@ -83,6 +88,11 @@ void SimulatorHeartbeat::execute( void )
     MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
     MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
     MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&local_frees, &global_local_frees, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&remote_frees, &global_remote_frees, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&arena_bytes, &global_arena_bytes, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&peak_arena_bytes, &global_peak_arena_bytes, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&live_bytes, &global_live_bytes, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
 #else
     global_max_tv_depth = local_max_tv_depth;
     global_max_sync_data_size = 0;
@@ -90,6 +100,11 @@ void SimulatorHeartbeat::execute( void )
     max_mempool_size = mempool_size;
     global_mempool_size = mempool_size;
     global_active_activities = active_activities;
+    global_local_frees = local_frees;
+    global_remote_frees = remote_frees;
+    global_arena_bytes = arena_bytes;
+    global_peak_arena_bytes = peak_arena_bytes;
+    global_live_bytes = live_bytes;
 #endif
 
 
@@ -108,12 +123,23 @@ void SimulatorHeartbeat::execute( void )
         sprintf(ua_buffer, "%" PRIu64 "B", global_mempool_size);
         UnitAlgebra global_mempool_size_ua(ua_buffer);
 
+        sprintf(ua_buffer, "%" PRIu64 "B", global_peak_arena_bytes);
+        UnitAlgebra global_peak_arena_ua(ua_buffer);
+
+        double fragmentation = global_arena_bytes ? 100.0 * (1.0 - (double)global_live_bytes / global_arena_bytes) : 0.0;
+
         sim_output.output("\tMax mempool usage:               %s\n",
                           max_mempool_size_ua.toStringBestSI().c_str());
         sim_output.output("\tGlobal mempool usage:            %s\n",
                           global_mempool_size_ua.toStringBestSI().c_str());
+        sim_output.output("\tGlobal mempool peak arena usage: %s\n",
+                          global_peak_arena_ua.toStringBestSI().c_str());
+        sim_output.output("\tGlobal mempool arenas free:      %.1f%%\n",
+                          fragmentation);
         sim_output.output("\tGlobal active activities         %" PRIu64 " activities\n",
                           global_active_activities);
+        sim_output.output("\tGlobal local/remote frees:       %" PRIu64 " / %" PRIu64 " activities\n",
+                          global_local_frees, global_remote_frees);
         sim_output.output("\tMax TimeVortex depth:            %" PRIu64 " entries\n",
                           global_max_tv_depth);
         sim_output.output("\tMax Sync data size:              %s\n",
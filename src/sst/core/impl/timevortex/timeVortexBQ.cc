@@ -0,0 +1,189 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include "sst/core/impl/timevortex/timeVortexBQ.h"
+
+#include <algorithm>
+
+#include "sst/core/output.h"
+
+namespace SST {
+namespace IMPL {
+
+TimeVortexBQ::TimeVortexBQ(Params& UNUSED(params)) :
+    TimeVortex(),
+    last_bucket(nullptr),
+    cur_batch(nullptr),
+    batch_time(0),
+    batch_priority(0),
+    insertOrder(0),
+    current_depth(0),
+    max_depth(0)
+{}
+
+TimeVortexBQ::~TimeVortexBQ()
+{
+    // Activities in TimeVortexBQ all need to be deleted
+    while ( !buckets.empty() ) {
+        Bucket* bucket = buckets.top();
+        buckets.pop();
+        for ( auto* it : bucket->list ) {
+            delete it;
+        }
+        delete bucket;
+    }
+    for ( auto* bucket : free_buckets ) {
+        delete bucket;
+    }
+}
+
+bool TimeVortexBQ::empty()
+{
+    return current_depth == 0;
+}
+
+int TimeVortexBQ::size()
+{
+    return current_depth;
+}
+
+void TimeVortexBQ::insert(Activity* activity)
+{
+    activity->setQueueOrder(insertOrder++);
+
+    SimTime_t time = activity->getDeliveryTime();
+    int priority = activity->getPriority();
+
+    // Activities that belong in the batch currently being executed go
+    // straight into the batch so they are delivered in order
+    if ( cur_batch != nullptr && !cur_batch->empty() && time == batch_time && priority == batch_priority ) {
+        insertSorted(*cur_batch, activity);
+        return;
+    }
+
+    Bucket* bucket = last_bucket;
+    if ( bucket == nullptr || bucket->time != time || bucket->priority != priority ) {
+        auto it = bucket_map.find(key_t(time, priority));
+        if ( it != bucket_map.end() ) {
+            bucket = it->second;
+        }
+        else {
+            if ( free_buckets.empty() ) {
+                bucket = new Bucket();
+            }
+            else {
+                bucket = free_buckets.back();
+                free_buckets.pop_back();
+            }
+            bucket->time = time;
+            bucket->priority = priority;
+            bucket->sorted = false;
+            bucket_map.emplace(key_t(time, priority), bucket);
+            buckets.push(bucket);
+        }
+        last_bucket = bucket;
+    }
+
+    if ( bucket->sorted ) insertSorted(bucket->list, activity);
+    else bucket->list.push_back(activity);
+
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+}
+
+Activity* TimeVortexBQ::pop()
+{
+    if ( current_depth == 0 ) return nullptr;
+
+    Bucket* bucket = frontBucket();
+    Activity* ret_val = bucket->list.back();
+    bucket->list.pop_back();
+    current_depth--;
+    if ( bucket->list.empty() ) removeFront();
+    return ret_val;
+}
+
+Activity* TimeVortexBQ::front()
+{
+    if ( current_depth == 0 ) return nullptr;
+    return frontBucket()->list.back();
+}
+
+void TimeVortexBQ::popBatch(std::vector<Activity*>& batch)
+{
+    Bucket* bucket = frontBucket();
+
+    // The bucket picks up the capacity of the old batch
+    batch.swap(bucket->list);
+    current_depth -= batch.size();
+
+    cur_batch = &batch;
+    batch_time = bucket->time;
+    batch_priority = bucket->priority;
+
+    removeFront();
+}
+
+TimeVortexBQ::Bucket* TimeVortexBQ::frontBucket()
+{
+    Bucket* bucket = buckets.top();
+    if ( !bucket->sorted ) {
+        // Activities were appended in insertion order, so reversing
+        // puts the next one at the back.  Link order may still need
+        // to be taken into account.
+        std::reverse(bucket->list.begin(), bucket->list.end());
+        if ( !std::is_sorted(bucket->list.begin(), bucket->list.end(), comp) ) {
+            std::sort(bucket->list.begin(), bucket->list.end(), comp);
+        }
+        bucket->sorted = true;
+    }
+    return bucket;
+}
+
+void TimeVortexBQ::removeFront()
+{
+    Bucket* bucket = buckets.top();
+    buckets.pop();
+    bucket_map.erase(key_t(bucket->time, bucket->priority));
+    if ( last_bucket == bucket ) last_bucket = nullptr;
+    bucket->list.clear();
+    free_buckets.push_back(bucket);
+}
+
+void TimeVortexBQ::insertSorted(std::vector<Activity*>& list, Activity* act)
+{
+    list.insert(std::upper_bound(list.begin(), list.end(), act, comp), act);
+}
+
+void TimeVortexBQ::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+    // Buckets can only be reached through the map without disturbing
+    // the heap
+    std::vector<Activity*> list;
+    for ( auto& entry : bucket_map ) {
+        list.insert(list.end(), entry.second->list.begin(), entry.second->list.end());
+    }
+    std::sort(list.begin(), list.end(), [this](Activity* lhs, Activity* rhs) { return comp(rhs, lhs); });
+    for ( auto* act : list ) {
+        act->print("  ", out);
+    }
+}
+
+
+} // namespace IMPL
+} // namespace SST
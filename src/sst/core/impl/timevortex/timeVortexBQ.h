@@ -0,0 +1,129 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXBQ_H
+#define SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXBQ_H
+
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "sst/core/timeVortex.h"
+#include "sst/core/eli/elementinfo.h"
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+
+
+/**
+ * Primary Event Queue with one bucket per (delivery time, priority).
+ *
+ * Buckets are kept in a binary heap ordered by time and priority.
+ * Activities within a bucket are left unsorted until the bucket
+ * reaches the front of the queue, at which point they are sorted
+ * with the same comparator as TimeVortexPQ.  popBatch() hands the
+ * whole front bucket to the caller.
+ */
+class TimeVortexBQ : public TimeVortex {
+
+public:
+    SST_ELI_REGISTER_DERIVED(
+        TimeVortex,
+        TimeVortexBQ,
+        "sst",
+        "timevortex.bucket_queue",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "TimeVortex with a bucket per delivery time and priority.  Delivers activities to the simulation in batches.")
+
+
+public:
+    TimeVortexBQ(Params& params);
+    ~TimeVortexBQ();
+
+    bool empty() override;
+    int size() override;
+    void insert(Activity* activity) override;
+    Activity* pop() override;
+    Activity* front() override;
+    void popBatch(std::vector<Activity*>& batch) override;
+    bool supportsBatch() const override { return true; }
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const override;
+
+    uint64_t getCurrentDepth() const override { return current_depth; }
+    uint64_t getMaxDepth() const override { return max_depth; }
+
+private:
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    typedef Activity::pq_less_time_priority_order comp_t;
+#else
+    typedef Activity::pq_less_time_priority comp_t;
+#endif
+
+    struct Bucket {
+        SimTime_t time;
+        int priority;
+        /* True once list has been sorted with the next activity at
+         * the back */
+        bool sorted;
+        std::vector<Activity*> list;
+    };
+
+    struct bucket_comp_t {
+        bool operator()(const Bucket* lhs, const Bucket* rhs) const {
+            if ( lhs->time == rhs->time ) return lhs->priority > rhs->priority;
+            return lhs->time > rhs->time;
+        }
+    };
+
+    typedef std::pair<SimTime_t, int> key_t;
+
+    struct key_hash_t {
+        size_t operator()(const key_t& key) const {
+            return std::hash<SimTime_t>()(key.first) ^ (std::hash<int>()(key.second) << 1);
+        }
+    };
+
+    /** Returns the bucket at the front of the queue, sorted */
+    Bucket* frontBucket();
+    /** Remove the front bucket from the queue */
+    void removeFront();
+    /** Insert act into list, which is sorted with the next activity
+     * at the back */
+    void insertSorted(std::vector<Activity*>& list, Activity* act);
+
+    std::priority_queue<Bucket*, std::vector<Bucket*>, bucket_comp_t> buckets;
+    std::unordered_map<key_t, Bucket*, key_hash_t> bucket_map;
+    /* Most recently used bucket; inserts tend to cluster */
+    Bucket* last_bucket;
+    std::vector<Bucket*> free_buckets;
+
+    /* Batch handed out by popBatch() that is still being executed */
+    std::vector<Activity*>* cur_batch;
+    SimTime_t batch_time;
+    int batch_priority;
+
+    uint64_t insertOrder;
+
+    uint64_t current_depth;
+    uint64_t max_depth;
+
+    comp_t comp;
+};
+
+} // namespace IMPL
+} //namespace SST
+
+#endif // SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXBQ_H
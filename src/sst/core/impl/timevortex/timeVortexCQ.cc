@@ -0,0 +1,255 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include "sst/core/impl/timevortex/timeVortexCQ.h"
+
+#include <algorithm>
+
+#include "sst/core/output.h"
+
+namespace SST {
+namespace IMPL {
+
+// Never shrink below this number of buckets
+static const size_t MIN_BUCKETS = 16;
+// Number of activities sampled to compute the bucket width
+static const size_t WIDTH_SAMPLE = 25;
+
+TimeVortexCQ::TimeVortexCQ(Params& UNUSED(params)) :
+    TimeVortex(),
+    buckets(MIN_BUCKETS),
+    bucket_mask(MIN_BUCKETS - 1),
+    width(1000),
+    cur_bucket(0),
+    cur_start(0),
+    next_valid(false),
+    grow_threshold(2 * MIN_BUCKETS),
+    shrink_threshold(0),
+    insertOrder(0),
+    current_depth(0),
+    max_depth(0)
+{}
+
+TimeVortexCQ::~TimeVortexCQ()
+{
+    // Activities in TimeVortexCQ all need to be deleted
+    for ( auto& bucket : buckets ) {
+        for ( auto* it : bucket ) {
+            delete it;
+        }
+        bucket.clear();
+    }
+}
+
+bool TimeVortexCQ::empty()
+{
+    return current_depth == 0;
+}
+
+int TimeVortexCQ::size()
+{
+    return current_depth;
+}
+
+void TimeVortexCQ::insert(Activity* activity)
+{
+    activity->setQueueOrder(insertOrder++);
+
+    SimTime_t time = activity->getDeliveryTime();
+    bucket_t& bucket = buckets[bucketFor(time)];
+    bucket.push_back(activity);
+    std::push_heap(bucket.begin(), bucket.end(), comp);
+
+    // Nothing in the queue is earlier than cur_start, so an activity
+    // before the current window is the new head of the queue
+    if ( time < cur_start ) {
+        setCursor(time);
+        next_valid = true;
+    }
+
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+
+    if ( current_depth > grow_threshold ) {
+        resize(2 * buckets.size());
+    }
+}
+
+Activity* TimeVortexCQ::pop()
+{
+    if ( current_depth == 0 ) return nullptr;
+    if ( !next_valid ) findNext();
+
+    bucket_t& bucket = buckets[cur_bucket];
+    std::pop_heap(bucket.begin(), bucket.end(), comp);
+    Activity* ret_val = bucket.back();
+    bucket.pop_back();
+    current_depth--;
+
+    // Anything left in the current window is in this bucket
+    next_valid = !bucket.empty() && bucket.front()->getDeliveryTime() < windowEnd();
+
+    if ( current_depth < shrink_threshold ) {
+        resize(buckets.size() / 2);
+    }
+    return ret_val;
+}
+
+Activity* TimeVortexCQ::front()
+{
+    if ( current_depth == 0 ) return nullptr;
+    if ( !next_valid ) findNext();
+    return buckets[cur_bucket].front();
+}
+
+void TimeVortexCQ::findNext()
+{
+    // Walk one year of buckets starting at the cursor, looking for
+    // an activity that falls in the window of the bucket
+    size_t index = cur_bucket;
+    SimTime_t start = cur_start;
+    for ( size_t i = 0; i <= bucket_mask; i++ ) {
+        SimTime_t end = ( MAX_SIMTIME_T - start < width ) ? MAX_SIMTIME_T : start + width;
+        bucket_t& bucket = buckets[index];
+        if ( !bucket.empty() && bucket.front()->getDeliveryTime() < end ) {
+            cur_bucket = index;
+            cur_start = start;
+            next_valid = true;
+            return;
+        }
+        if ( end == MAX_SIMTIME_T ) break;
+        index = (index + 1) & bucket_mask;
+        start = end;
+    }
+
+    // Nothing in the next year, so do a direct search of the bucket
+    // heads for the earliest activity
+    Activity* next = nullptr;
+    for ( auto& bucket : buckets ) {
+        if ( bucket.empty() ) continue;
+        if ( next == nullptr || comp(next, bucket.front()) ) {
+            next = bucket.front();
+        }
+    }
+    setCursor(next->getDeliveryTime());
+    next_valid = true;
+}
+
+void TimeVortexCQ::setCursor(SimTime_t time)
+{
+    cur_start = (time / width) * width;
+    cur_bucket = bucketFor(time);
+}
+
+SimTime_t TimeVortexCQ::computeWidth(std::vector<Activity*>& list) const
+{
+    // Sample the earliest activities, ignoring anything scheduled for
+    // the end of time (i.e. the StopAction placed by Simulation::run())
+    std::vector<SimTime_t> times;
+    times.reserve(list.size());
+    for ( auto* act : list ) {
+        if ( act->getDeliveryTime() != MAX_SIMTIME_T ) {
+            times.push_back(act->getDeliveryTime());
+        }
+    }
+
+    size_t nsample = std::min(times.size(), WIDTH_SAMPLE);
+    if ( nsample < 2 ) return width;
+    std::partial_sort(times.begin(), times.begin() + nsample, times.end());
+
+    // Average separation of distinct times.  Make a second pass
+    // ignoring any separations that are more than twice the average.
+    double total = 0.0;
+    size_t count = 0;
+    for ( size_t i = 1; i < nsample; i++ ) {
+        SimTime_t gap = times[i] - times[i-1];
+        if ( gap == 0 ) continue;
+        total += gap;
+        count++;
+    }
+    if ( count == 0 ) return width;
+    double average = total / count;
+
+    total = 0.0;
+    count = 0;
+    for ( size_t i = 1; i < nsample; i++ ) {
+        SimTime_t gap = times[i] - times[i-1];
+        if ( gap == 0 || gap > 2.0 * average ) continue;
+        total += gap;
+        count++;
+    }
+    if ( count != 0 ) average = total / count;
+
+    double new_width = 3.0 * average;
+    if ( new_width < 1.0 ) return 1;
+    if ( new_width > (double)(MAX_SIMTIME_T / 4) ) return MAX_SIMTIME_T / 4;
+    return (SimTime_t)new_width;
+}
+
+void TimeVortexCQ::resize(size_t nbuckets)
+{
+    std::vector<Activity*> list;
+    list.reserve(current_depth);
+    for ( auto& bucket : buckets ) {
+        list.insert(list.end(), bucket.begin(), bucket.end());
+    }
+
+    width = computeWidth(list);
+
+    buckets.clear();
+    buckets.resize(nbuckets);
+    bucket_mask = nbuckets - 1;
+    grow_threshold = 2 * nbuckets;
+    shrink_threshold = nbuckets > MIN_BUCKETS ? nbuckets / 2 : 0;
+
+    Activity* next = nullptr;
+    for ( auto* act : list ) {
+        buckets[bucketFor(act->getDeliveryTime())].push_back(act);
+        if ( next == nullptr || comp(next, act) ) {
+            next = act;
+        }
+    }
+    for ( auto& bucket : buckets ) {
+        std::make_heap(bucket.begin(), bucket.end(), comp);
+    }
+
+    if ( next != nullptr ) {
+        setCursor(next->getDeliveryTime());
+        next_valid = true;
+    }
+    else {
+        setCursor(cur_start);
+        next_valid = false;
+    }
+}
+
+void TimeVortexCQ::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+    std::vector<Activity*> list;
+    for ( auto& bucket : buckets ) {
+        list.insert(list.end(), bucket.begin(), bucket.end());
+    }
+    std::sort(list.begin(), list.end(), [this](Activity* lhs, Activity* rhs) { return comp(rhs, lhs); });
+    for ( auto* act : list ) {
+        act->print("  ", out);
+    }
+}
+
+
+} // namespace IMPL
+} // namespace SST
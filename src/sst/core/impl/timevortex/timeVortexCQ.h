@@ -0,0 +1,117 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXCQ_H
+#define SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXCQ_H
+
+#include <vector>
+
+#include "sst/core/timeVortex.h"
+#include "sst/core/eli/elementinfo.h"
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+
+
+/**
+ * Primary Event Queue based on a calendar queue.
+ *
+ * Activities are hashed into buckets by delivery time.  Each bucket
+ * covers a window of "width" core cycles and the set of buckets
+ * covers one "year".  Within a bucket, activities are kept in a
+ * binary heap using the same comparator as TimeVortexPQ, so the
+ * order in which activities are returned is identical to that of
+ * TimeVortexPQ.  The number of buckets and the bucket width are
+ * recomputed whenever the occupancy of the queue grows or shrinks
+ * past a threshold.
+ */
+class TimeVortexCQ : public TimeVortex {
+
+public:
+    SST_ELI_REGISTER_DERIVED(
+        TimeVortex,
+        TimeVortexCQ,
+        "sst",
+        "timevortex.calendar_queue",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "TimeVortex based on a calendar queue with adaptive bucket width.")
+
+
+public:
+    TimeVortexCQ(Params& params);
+    ~TimeVortexCQ();
+
+    bool empty() override;
+    int size() override;
+    void insert(Activity* activity) override;
+    Activity* pop() override;
+    Activity* front() override;
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const override;
+
+    uint64_t getCurrentDepth() const override { return current_depth; }
+    uint64_t getMaxDepth() const override { return max_depth; }
+
+private:
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    typedef Activity::pq_less_time_priority_order comp_t;
+#else
+    typedef Activity::pq_less_time_priority comp_t;
+#endif
+    typedef std::vector<Activity*> bucket_t;
+
+    /** Find the bucket holding the next activity and point the
+     * cursor at it */
+    void findNext();
+    /** Rebuild the calendar with the given number of buckets */
+    void resize(size_t nbuckets);
+    /** Compute a new bucket width from the activities in list */
+    SimTime_t computeWidth(std::vector<Activity*>& list) const;
+    /** Move the cursor to the window containing time */
+    void setCursor(SimTime_t time);
+
+    inline size_t bucketFor(SimTime_t time) const {
+        return (time / width) & bucket_mask;
+    }
+
+    inline SimTime_t windowEnd() const {
+        return ( MAX_SIMTIME_T - cur_start < width ) ? MAX_SIMTIME_T : cur_start + width;
+    }
+
+    std::vector<bucket_t> buckets;
+    size_t bucket_mask;
+    SimTime_t width;
+
+    /* Cursor:  current bucket and the start time of its window */
+    size_t cur_bucket;
+    SimTime_t cur_start;
+    /* True if buckets[cur_bucket] holds the next activity */
+    bool next_valid;
+
+    size_t grow_threshold;
+    size_t shrink_threshold;
+
+    uint64_t insertOrder;
+
+    uint64_t current_depth;
+    uint64_t max_depth;
+
+    comp_t comp;
+};
+
+} // namespace IMPL
+} //namespace SST
+
+#endif // SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXCQ_H
@@ -0,0 +1,279 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include "sst/core/impl/timevortex/timeVortexLQ.h"
+
+#include <algorithm>
+
+#include "sst/core/output.h"
+
+namespace SST {
+namespace IMPL {
+
+// Buckets (and bottom) larger than this are split into a new rung
+static const size_t THRESHOLD = 50;
+// Maximum number of rungs in the ladder
+static const size_t MAX_RUNGS = 8;
+
+SimTime_t TimeVortexLQ::Rung::curStart() const
+{
+    SimTime_t offset = cur * width;
+    return ( MAX_SIMTIME_T - start < offset ) ? MAX_SIMTIME_T : start + offset;
+}
+
+TimeVortexLQ::TimeVortexLQ(Params& UNUSED(params)) :
+    TimeVortex(),
+    top_start(0),
+    top_open(true),
+    bottom_limit(THRESHOLD),
+    insertOrder(0),
+    current_depth(0),
+    max_depth(0)
+{}
+
+TimeVortexLQ::~TimeVortexLQ()
+{
+    // Activities in TimeVortexLQ all need to be deleted
+    for ( auto* it : top ) {
+        delete it;
+    }
+    for ( auto& rung : rungs ) {
+        for ( auto& bucket : rung.buckets ) {
+            for ( auto* it : bucket ) {
+                delete it;
+            }
+        }
+    }
+    for ( auto* it : bottom ) {
+        delete it;
+    }
+    for ( auto* it : end_of_time ) {
+        delete it;
+    }
+}
+
+bool TimeVortexLQ::empty()
+{
+    return current_depth == 0;
+}
+
+int TimeVortexLQ::size()
+{
+    return current_depth;
+}
+
+void TimeVortexLQ::insert(Activity* activity)
+{
+    activity->setQueueOrder(insertOrder++);
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+
+    SimTime_t time = activity->getDeliveryTime();
+    if ( time == MAX_SIMTIME_T ) {
+        end_of_time.push_back(activity);
+        return;
+    }
+
+    if ( top_open && time >= top_start ) {
+        top.push_back(activity);
+        return;
+    }
+
+    for ( auto& rung : rungs ) {
+        if ( time >= rung.curStart() ) {
+            rung.insert(activity);
+            return;
+        }
+    }
+
+    // Earlier than everything in the ladder, so goes into bottom in
+    // sorted order.  New activities tend to land near the back.
+    auto it = std::upper_bound(bottom.begin(), bottom.end(), activity,
+                               [this](Activity* lhs, Activity* rhs) { return comp(rhs, lhs); });
+    bottom.insert(it, activity);
+
+    if ( bottom.size() > bottom_limit ) spawnFromBottom();
+}
+
+Activity* TimeVortexLQ::pop()
+{
+    if ( current_depth == 0 ) return nullptr;
+    if ( bottom.empty() ) refillBottom();
+
+    Activity* ret_val;
+    if ( !bottom.empty() ) {
+        ret_val = bottom.front();
+        bottom.pop_front();
+    }
+    else {
+        // Only end of time activities are left
+        auto it = nextEndOfTime();
+        ret_val = *it;
+        end_of_time.erase(it);
+    }
+    current_depth--;
+    return ret_val;
+}
+
+Activity* TimeVortexLQ::front()
+{
+    if ( current_depth == 0 ) return nullptr;
+    if ( bottom.empty() ) refillBottom();
+    if ( bottom.empty() ) return *nextEndOfTime();
+    return bottom.front();
+}
+
+std::vector<Activity*>::iterator TimeVortexLQ::nextEndOfTime()
+{
+    return std::min_element(end_of_time.begin(), end_of_time.end(),
+                            [this](Activity* lhs, Activity* rhs) { return comp(rhs, lhs); });
+}
+
+void TimeVortexLQ::refillBottom()
+{
+    while ( bottom.empty() ) {
+        if ( rungs.empty() ) {
+            if ( top.empty() ) {
+                // Queue is empty, start over with everything going to top
+                top_start = 0;
+                top_open = true;
+                return;
+            }
+            transferTop();
+            continue;
+        }
+
+        Rung& rung = rungs.back();
+        while ( rung.cur < rung.buckets.size() && rung.buckets[rung.cur].empty() ) {
+            rung.cur++;
+        }
+        if ( rung.cur == rung.buckets.size() ) {
+            rungs.pop_back();
+            continue;
+        }
+
+        bucket_t& bucket = rung.buckets[rung.cur];
+        SimTime_t bucket_start = rung.curStart();
+        rung.cur++;
+
+        if ( bucket.size() > THRESHOLD && rungs.size() < MAX_RUNGS &&
+             !std::all_of(bucket.begin(), bucket.end(), [&bucket](Activity* act) {
+                     return act->getDeliveryTime() == bucket.front()->getDeliveryTime(); }) ) {
+            // Split the bucket into a new rung covering the same window
+            bucket_t list;
+            list.swap(bucket);
+            SimTime_t width = rung.width / list.size() + 1;
+            rungs.emplace_back(bucket_start, width, list.size());
+            for ( auto* act : list ) {
+                rungs.back().insert(act);
+            }
+            continue;
+        }
+
+        bottom.assign(bucket.begin(), bucket.end());
+        bucket_t().swap(bucket);
+        sortBottom();
+        // Buckets that can't be split (all activities at the same
+        // time) can leave bottom over the threshold.  Give it room to
+        // grow so we don't respawn a rung on every insert.
+        bottom_limit = std::max(THRESHOLD, 2 * bottom.size());
+    }
+}
+
+void TimeVortexLQ::transferTop()
+{
+    SimTime_t min_time = MAX_SIMTIME_T;
+    SimTime_t max_time = 0;
+    for ( auto* act : top ) {
+        SimTime_t time = act->getDeliveryTime();
+        min_time = std::min(min_time, time);
+        max_time = std::max(max_time, time);
+    }
+    size_t count = top.size();
+
+    // Choose the width so that the rung covers max_time
+    SimTime_t width = (max_time - min_time) / count + 1;
+    SimTime_t span = count * width;
+    if ( MAX_SIMTIME_T - min_time < span ) {
+        top_open = false;
+    }
+    else {
+        top_open = true;
+        top_start = min_time + span;
+    }
+
+    rungs.emplace_back(min_time, width, count);
+    Rung& rung = rungs.back();
+
+    std::vector<Activity*> list;
+    list.swap(top);
+    for ( auto* act : list ) {
+        if ( top_open && act->getDeliveryTime() >= top_start ) {
+            top.push_back(act);
+        }
+        else {
+            rung.insert(act);
+        }
+    }
+}
+
+void TimeVortexLQ::spawnFromBottom()
+{
+    if ( rungs.size() >= MAX_RUNGS ) return;
+    if ( bottom.front()->getDeliveryTime() == bottom.back()->getDeliveryTime() ) return;
+
+    // The new rung has to cover everything earlier than the lowest
+    // existing rung (or top if there are no rungs)
+    SimTime_t end;
+    if ( !rungs.empty() ) end = rungs.back().curStart();
+    else if ( top_open ) end = top_start;
+    else return;
+
+    SimTime_t start = bottom.front()->getDeliveryTime();
+    SimTime_t width = (end - start) / bottom.size() + 1;
+    rungs.emplace_back(start, width, bottom.size());
+    for ( auto* act : bottom ) {
+        rungs.back().insert(act);
+    }
+    bottom.clear();
+}
+
+void TimeVortexLQ::sortBottom()
+{
+    std::sort(bottom.begin(), bottom.end(), [this](Activity* lhs, Activity* rhs) { return comp(rhs, lhs); });
+}
+
+void TimeVortexLQ::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+    std::vector<Activity*> list(top.begin(), top.end());
+    for ( auto& rung : rungs ) {
+        for ( auto& bucket : rung.buckets ) {
+            list.insert(list.end(), bucket.begin(), bucket.end());
+        }
+    }
+    list.insert(list.end(), bottom.begin(), bottom.end());
+    list.insert(list.end(), end_of_time.begin(), end_of_time.end());
+    std::sort(list.begin(), list.end(), [this](Activity* lhs, Activity* rhs) { return comp(rhs, lhs); });
+    for ( auto* act : list ) {
+        act->print("  ", out);
+    }
+}
+
+
+} // namespace IMPL
+} // namespace SST
@@ -0,0 +1,138 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXLQ_H
+#define SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXLQ_H
+
+#include <deque>
+#include <vector>
+
+#include "sst/core/timeVortex.h"
+#include "sst/core/eli/elementinfo.h"
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+
+
+/**
+ * Primary Event Queue based on a ladder queue.
+ *
+ * The queue is made up of three tiers:
+ *  - Top:  unsorted list of far-future activities
+ *  - Ladder:  rungs of buckets, each rung subdividing a single
+ *    bucket of the rung above it.  Buckets are left unsorted.
+ *  - Bottom:  sorted list of the activities that will be delivered
+ *    next.
+ *
+ * The tiers partition delivery time, so activities with the same
+ * delivery time always end up in the same tier.  Bottom is sorted
+ * with the same comparator as TimeVortexPQ, which keeps the delivery
+ * order identical to TimeVortexPQ.
+ *
+ * Activities scheduled for the end of time (e.g. the StopAction
+ * placed by Simulation::run()) are held outside the tiers and only
+ * delivered once the tiers are empty, so they never pin a rung or
+ * bottom open.
+ */
+class TimeVortexLQ : public TimeVortex {
+
+public:
+    SST_ELI_REGISTER_DERIVED(
+        TimeVortex,
+        TimeVortexLQ,
+        "sst",
+        "timevortex.ladder_queue",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "TimeVortex based on a ladder queue.  Suited to skewed and far-future event distributions.")
+
+
+public:
+    TimeVortexLQ(Params& params);
+    ~TimeVortexLQ();
+
+    bool empty() override;
+    int size() override;
+    void insert(Activity* activity) override;
+    Activity* pop() override;
+    Activity* front() override;
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const override;
+
+    uint64_t getCurrentDepth() const override { return current_depth; }
+    uint64_t getMaxDepth() const override { return max_depth; }
+
+private:
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    typedef Activity::pq_less_time_priority_order comp_t;
+#else
+    typedef Activity::pq_less_time_priority comp_t;
+#endif
+    typedef std::vector<Activity*> bucket_t;
+
+    struct Rung {
+        SimTime_t start;
+        SimTime_t width;
+        size_t cur;
+        std::vector<bucket_t> buckets;
+
+        Rung(SimTime_t start, SimTime_t width, size_t nbuckets) :
+            start(start), width(width), cur(0), buckets(nbuckets)
+        {}
+
+        /** Start time of the bucket currently being dequeued */
+        SimTime_t curStart() const;
+        void insert(Activity* act) {
+            buckets[(act->getDeliveryTime() - start) / width].push_back(act);
+        }
+    };
+
+    /** Move activities into bottom until it is non-empty or the
+     * queue is empty */
+    void refillBottom();
+    /** Turn the contents of top into a new rung */
+    void transferTop();
+    /** Turn an oversized bottom into a new rung */
+    void spawnFromBottom();
+    /** Sort activities so the next one to deliver is first */
+    void sortBottom();
+    /** Next of the end of time activities to deliver */
+    std::vector<Activity*>::iterator nextEndOfTime();
+
+    std::vector<Activity*> top;
+    SimTime_t top_start;
+    /* False if the first rung extends to the end of time */
+    bool top_open;
+
+    std::vector<Rung> rungs;
+
+    std::deque<Activity*> bottom;
+    /* Size of bottom that triggers spawning a new rung */
+    size_t bottom_limit;
+
+    /* Activities delivered at MAX_SIMTIME_T */
+    std::vector<Activity*> end_of_time;
+
+    uint64_t insertOrder;
+
+    uint64_t current_depth;
+    uint64_t max_depth;
+
+    comp_t comp;
+};
+
+} // namespace IMPL
+} //namespace SST
+
+#endif // SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXLQ_H
@@ -59,6 +59,18 @@ void TimeVortexPQ::insert(Activity* activity)
     }
 }
 
+void TimeVortexPQ::insertBatch(const std::vector<Activity*>& batch)
+{
+    for ( auto* act : batch ) {
+        act->setQueueOrder(insertOrder++);
+        data.push(act);
+    }
+    current_depth += batch.size();
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+}
+
 Activity* TimeVortexPQ::pop()
 {
     if ( data.empty() ) return nullptr;
@@ -49,6 +49,7 @@ public:
     bool empty() override;
     int size() override;
     void insert(Activity* activity) override;
+    void insertBatch(const std::vector<Activity*>& batch) override;
     Activity* pop() override;
     Activity* front() override;
 
@@ -39,11 +39,13 @@ Link::Link(LinkId_t id) :
     latency(1),
     type(HANDLER),
     id(id),
-    configured(false)
+    configured(false),
+    coalesce(false)
 {
+    sim = Simulation::getSimulation();
     recvQueue = uninitQueue;
     untimedQueue = nullptr;
-    configuredQueue = Simulation::getSimulation()->getTimeVortex();
+    configuredQueue = sim->getTimeVortex();
 }
 
 Link::Link() :
@@ -52,11 +54,13 @@ Link::Link() :
     latency(1),
     type(HANDLER),
     id(-1),
-    configured(false)
+    configured(false),
+    coalesce(false)
 {
+    sim = Simulation::getSimulation();
     recvQueue = uninitQueue;
     untimedQueue = nullptr;
-    configuredQueue = Simulation::getSimulation()->getTimeVortex();
+    configuredQueue = sim->getTimeVortex();
 }
 
 Link::~Link() {
@@ -64,6 +68,7 @@ Link::~Link() {
         delete recvQueue;
     }
     if ( rFunctor != nullptr ) delete rFunctor;
+    for ( auto* ev : pending ) delete ev;
 }
 
 void Link::finalizeConfiguration() {
@@ -116,10 +121,10 @@ void Link::addRecvLatency(SimTime_t cycles, TimeConverter* timebase) {
 
 void Link::send( SimTime_t delay, TimeConverter* tc, Event* event ) {
     if ( tc == nullptr ) {
-        Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, 1, "Cannot send an event on Link with nullptr TimeConverter\n");
+        sim->getSimulationOutput().fatal(CALL_INFO, 1, "Cannot send an event on Link with nullptr TimeConverter\n");
     }
 
-    Cycle_t cycle = Simulation::getSimulation()->getCurrentSimCycle() +
+    Cycle_t cycle = sim->getCurrentSimCycle() +
         tc->convertToCoreTime(delay) + latency;
 
     if ( event == nullptr ) {
@@ -133,25 +138,91 @@ void Link::send( SimTime_t delay, TimeConverter* tc, Event* event ) {
     event->addRecvComponent(pair_link->comp, pair_link->ctype, pair_link->port);
 #endif
 
+    if ( UNLIKELY( coalesce ) ) {
+        sendCoalesced(event);
+        return;
+    }
+
     // trace.getOutput().output(CALL_INFO, "%p\n",pair_link->recvQueue);
     pair_link->recvQueue->insert( event );
 }
 
+void Link::sendBatch( const std::vector<std::pair<SimTime_t, Event*>>& events, TimeConverter* tc ) {
+    if ( tc == nullptr ) {
+        sim->getSimulationOutput().fatal(CALL_INFO, 1, "Cannot send an event on Link with nullptr TimeConverter\n");
+    }
+
+    // Reused between calls; the receiving queue doesn't keep it
+    static thread_local std::vector<Activity*> batch;
+    batch.clear();
+
+    Cycle_t base = sim->getCurrentSimCycle() + latency;
+    for ( auto& item : events ) {
+        Event* event = item.second;
+        if ( event == nullptr ) {
+            event = new NullEvent();
+        }
+        event->setDeliveryTime(base + tc->convertToCoreTime(item.first));
+        event->setDeliveryLink(id,pair_link);
+
+#if __SST_DEBUG_EVENT_TRACKING__
+        event->addSendComponent(comp, ctype, port);
+        event->addRecvComponent(pair_link->comp, pair_link->ctype, pair_link->port);
+#endif
+        if ( UNLIKELY( coalesce ) ) sendCoalesced(event);
+        else batch.push_back(event);
+    }
+
+    if ( !batch.empty() ) pair_link->recvQueue->insertBatch(batch);
+}
+
+void Link::sendCoalesced(Event* event) {
+    // Events for the current time can't wait for the time step to end
+    if ( event->getDeliveryTime() == sim->getCurrentSimCycle() ) {
+        pair_link->recvQueue->insert( event );
+        return;
+    }
+
+    // Only the latest held event for a time and priority is tried,
+    // so merged events are never moved ahead of another event for
+    // the same time and priority
+    for ( auto it = pending.rbegin(); it != pending.rend(); ++it ) {
+        Event* held = *it;
+        if ( held->getDeliveryTime() != event->getDeliveryTime() ||
+             held->getPriority() != event->getPriority() ) continue;
+        if ( held->merge(event) ) {
+            delete event;
+            return;
+        }
+        break;
+    }
+
+    // The Simulation flushes the Link at the end of the time step
+    if ( pending.empty() ) sim->coalescedLinks.push_back(this);
+    pending.push_back(event);
+}
+
+void Link::flushCoalesced() {
+    for ( auto* ev : pending ) {
+        pair_link->recvQueue->insert( ev );
+    }
+    pending.clear();
+}
+
 
 Event* Link::recv()
 {
     // Check to make sure this is a polling link
     if ( UNLIKELY( type != POLL ) ) {
-        Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, 1, "Cannot call recv on a Link with an event handler installed (non-polling link.\n");
+        sim->getSimulationOutput().fatal(CALL_INFO, 1, "Cannot call recv on a Link with an event handler installed (non-polling link.\n");
 
     }
 
     Event* event = nullptr;
-    Simulation *simulation = Simulation::getSimulation();
 
     if ( !recvQueue->empty() ) {
     Activity* activity = recvQueue->front();
-    if ( activity->getDeliveryTime() <=  simulation->getCurrentSimCycle() ) {
+    if ( activity->getDeliveryTime() <=  sim->getCurrentSimCycle() ) {
         event = static_cast<Event*>(activity);
         recvQueue->pop();
     }
@@ -164,8 +235,8 @@ void Link::sendUntimedData(Event* data)
     if ( pair_link->untimedQueue == nullptr ) {
         pair_link->untimedQueue = new InitQueue();
     }
-    Simulation::getSimulation()->untimed_msg_count++;
-    data->setDeliveryTime(Simulation::getSimulation()->untimed_phase + 1);
+    sim->untimed_msg_count++;
+    data->setDeliveryTime(sim->untimed_phase + 1);
     data->setDeliveryLink(id,pair_link);
 
     pair_link->untimedQueue->insert(data);
@@ -192,7 +263,7 @@ Event* Link::recvUntimedData()
     Event* event = nullptr;
     if ( !untimedQueue->empty() ) {
     Activity* activity = untimedQueue->front();
-    if ( activity->getDeliveryTime() <= Simulation::getSimulation()->untimed_phase ) {
+    if ( activity->getDeliveryTime() <= sim->untimed_phase ) {
         event = static_cast<Event*>(activity);
         untimedQueue->pop();
     }
@@ -16,6 +16,9 @@
 
 #include "sst/core/event.h"
 
+#include <utility>
+#include <vector>
+
 namespace SST {
 
 #define _LINK_DBG( fmt, args...) __DBG( DBG_LINK, Link, fmt, ## args )
@@ -41,6 +44,7 @@ public:
     friend class ThreadSync;
     friend class SyncManager;
     friend class ComponentInfo;
+    friend class ThreadLoadBalancer;
 
     /** Create a new link with a given ID */
     Link(LinkId_t id);
@@ -106,6 +110,24 @@ public:
         send( 0, event );
     }
 
+    /** Send a group of events at once.  Each event is sent with its
+      own additional delay, exactly as if send() had been called for
+      each one in order, but they are handed to the receiving queue
+      in a single operation.
+      @param events Pairs of additional delay and event to send.  A
+             nullptr event sends a NullEvent.
+      @param tc Time converter to specify units for the delays
+      */
+    void sendBatch( const std::vector<std::pair<SimTime_t, Event*>>& events, TimeConverter* tc );
+
+    /** Send a group of events at once, with delays in units of the
+      default Link timebase
+      @param events Pairs of additional delay and event to send
+      */
+    inline void sendBatch( const std::vector<std::pair<SimTime_t, Event*>>& events ) {
+        sendBatch(events, defaultTimeBase);
+    }
+
 
     /** Retrieve a pending event from the Link. For links which do not
       have a set event handler, they can be polled with this function.
@@ -201,6 +223,10 @@ protected:
     /** Pointer to the opposite side of this link */
     Link* pair_link;
 
+    /** Simulation that owns this link.  Cached so the send and recv
+     * paths don't have to look it up. */
+    Simulation* sim;
+
 private:
     Link( const Link& l );
 
@@ -211,10 +237,23 @@ private:
     void finalizeConfiguration();
     void prepareForComplete();
 
+    /** Hold event back so later events for the same time can be
+     * merged into it */
+    void sendCoalesced(Event* event);
+    /** Pass the held back events on to the receiving queue */
+    void flushCoalesced();
+
     Type_t type;
     LinkId_t id;
     bool configured;
 
+    /** Set if events sent during the same time step for the same
+     * delivery time are merged */
+    bool coalesce;
+    /** Events held back until the end of the time step, in the order
+     * they were sent */
+    std::vector<Event*> pending;
+
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     std::string comp;
     std::string ctype;
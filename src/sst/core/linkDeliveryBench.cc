@@ -0,0 +1,302 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * sst-bench-linkdelivery: micro-benchmark for the receive side of
+ * cross-rank event delivery.
+ *
+ * Events are sent on randomly chosen links through a SyncQueue,
+ * serialized and unpacked as they would be by a rank sync, and then
+ * matched to the receiving link.  The "map" method tags events with
+ * the link id and finds the link in a std::map, as the rank syncs used
+ * to.  The "index" method sends through a RankSyncLinkQueue per link,
+ * which tags events with the link's position in a table.  Tagging,
+ * serialization and lookup are timed separately.
+ */
+
+#include "sst_config.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sst/core/event.h"
+#include "sst/core/serialization/serializer.h"
+#include "sst/core/syncQueue.h"
+
+using namespace SST;
+
+namespace {
+
+/** Event sent between the ranks */
+class BenchEvent : public Event {
+public:
+    BenchEvent() : Event() {}
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+    }
+
+    ImplementSerializable(BenchEvent)
+};
+
+/** Stands in for the receiving Link */
+struct BenchLink {
+    uint64_t delivered;
+};
+
+enum Method_t { MAP, INDEX };
+
+struct BenchConfig {
+    std::vector<uint64_t> links;
+    uint64_t events;
+    uint64_t batch;
+    uint64_t seed;
+
+    BenchConfig() :
+        events(1000000),
+        batch(1024),
+        seed(1)
+    {}
+};
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsedNS(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+bool runBenchmark(const BenchConfig& cfg, Method_t method, uint64_t num_links)
+{
+    std::mt19937_64 rng(cfg.seed);
+
+    // Links to another rank are a scattered subset of all the link ids
+    std::vector<LinkId_t> ids;
+    ids.reserve(num_links);
+    for ( uint64_t i = 0; i < num_links; i++ ) {
+        ids.push_back(i * 4 + rng() % 4);
+    }
+
+    std::vector<BenchLink> links(num_links);
+    std::map<LinkId_t, BenchLink*> link_map;
+    std::vector<BenchLink*> link_table;
+    std::vector<RankSyncLinkQueue*> link_queues;
+    SyncQueue squeue;
+
+    for ( uint64_t i = 0; i < num_links; i++ ) {
+        links[i].delivered = 0;
+        if ( method == MAP ) {
+            link_map[ids[i]] = &links[i];
+        }
+        else {
+            link_table.push_back(&links[i]);
+            link_queues.push_back(new RankSyncLinkQueue(&squeue, i));
+        }
+    }
+
+    std::uniform_int_distribution<uint64_t> pick(0, num_links - 1);
+    std::vector<uint64_t> targets(cfg.batch);
+    double tag_ns = 0.0;
+    double ser_ns = 0.0;
+    double lookup_ns = 0.0;
+    uint64_t sent = 0;
+
+    while ( sent < cfg.events ) {
+        uint64_t count = std::min(cfg.batch, cfg.events - sent);
+        for ( uint64_t i = 0; i < count; i++ ) targets[i] = pick(rng);
+
+        // Link::send tags every event with the link id before handing
+        // it to the queue
+        auto start = bench_clock::now();
+        for ( uint64_t i = 0; i < count; i++ ) {
+            uint64_t k = targets[i];
+            BenchEvent* ev = new BenchEvent();
+            ev->setDeliveryLink(ids[k], nullptr);
+            if ( method == MAP ) squeue.insert(ev);
+            else link_queues[k]->insert(ev);
+        }
+        tag_ns += elapsedNS(start);
+
+        start = bench_clock::now();
+        char* buffer = squeue.getData();
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+        SST::Core::Serialization::serializer ser;
+        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)], hdr->buffer_size - sizeof(SyncQueue::Header));
+        std::vector<Activity*> activities;
+        ser & activities;
+        ser_ns += elapsedNS(start);
+
+        start = bench_clock::now();
+        for ( auto* act : activities ) {
+            Event* ev = static_cast<Event*>(act);
+            if ( method == MAP ) {
+                auto link = link_map.find(ev->getLinkId());
+                if ( link == link_map.end() ) {
+                    fprintf(stderr, "ERROR: Link %d not found in map\n", ev->getLinkId());
+                    return false;
+                }
+                link->second->delivered++;
+            }
+            else {
+                size_t index = ev->getLinkId();
+                if ( index >= link_table.size() ) {
+                    fprintf(stderr, "ERROR: Link index %zu out of range\n", index);
+                    return false;
+                }
+                link_table[index]->delivered++;
+            }
+        }
+        lookup_ns += elapsedNS(start);
+
+        for ( auto* act : activities ) delete act;
+        sent += count;
+    }
+
+    // Both methods must deliver every event to the link it was sent on
+    rng.seed(cfg.seed);
+    for ( uint64_t i = 0; i < num_links; i++ ) rng();
+    std::vector<uint64_t> expected(num_links, 0);
+    for ( uint64_t i = 0; i < cfg.events; i++ ) expected[pick(rng)]++;
+    for ( uint64_t i = 0; i < num_links; i++ ) {
+        if ( links[i].delivered != expected[i] ) {
+            fprintf(stderr, "ERROR: Events delivered to the wrong link\n");
+            return false;
+        }
+    }
+
+    for ( auto* queue : link_queues ) delete queue;
+
+    printf("%-6s %10" PRIu64 " %12" PRIu64 " %10.1f %10.1f %10.1f %10.1f\n",
+           method == MAP ? "map" : "index", num_links, cfg.events,
+           tag_ns / sent, ser_ns / sent, lookup_ns / sent,
+           (tag_ns + ser_ns + lookup_ns) / sent);
+    return true;
+}
+
+std::vector<uint64_t> splitList(const std::string& str)
+{
+    std::vector<uint64_t> ret;
+    std::stringstream ss(str);
+    std::string item;
+    while ( std::getline(ss, item, ',') ) {
+        if ( item.empty() ) continue;
+        ret.push_back(strtoull(item.c_str(), nullptr, 0));
+    }
+    return ret;
+}
+
+void outputUsage(const char* app)
+{
+    printf("Usage: %s [options]\n", app);
+    printf("Options:\n");
+    printf("  -h, --help               Print help message\n");
+    printf("  -m, --method=METHOD      Link lookup {map, index, all} (default: all)\n");
+    printf("  -l, --links=LIST         Comma separated list of remote link counts (default: 1000,1000000)\n");
+    printf("  -n, --events=N           Number of events delivered per run (default: 1000000)\n");
+    printf("  -b, --batch=N            Events exchanged per sync (default: 1024)\n");
+    printf("      --seed=N             Random seed (default: 1)\n");
+    printf("\n");
+    printf("Reports ns per event to tag and queue it, to serialize and unpack it, and\n");
+    printf("to find the receiving link.\n");
+}
+
+int parseCmdLine(int argc, char* argv[], BenchConfig& cfg, std::vector<Method_t>& methods)
+{
+    static const struct option longOpts[] = {
+        {"help",        no_argument,        nullptr, 'h'},
+        {"method",      required_argument,  nullptr, 'm'},
+        {"links",       required_argument,  nullptr, 'l'},
+        {"events",      required_argument,  nullptr, 'n'},
+        {"batch",       required_argument,  nullptr, 'b'},
+        {"seed",        required_argument,  nullptr, 0},
+        {nullptr, 0, nullptr, 0}
+    };
+    methods = { MAP, INDEX };
+    while (1) {
+        int opt_idx = 0;
+        const int intC = getopt_long(argc, argv, "hm:l:n:b:", longOpts, &opt_idx);
+        if ( intC == -1 )
+            break;
+
+        const char c = static_cast<char>(intC);
+
+        switch (c) {
+        case 'h':
+            outputUsage(argv[0]);
+            return 1;
+        case 'm':
+            if ( !strcmp(optarg, "map") ) methods = { MAP };
+            else if ( !strcmp(optarg, "index") ) methods = { INDEX };
+            else if ( !strcmp(optarg, "all") ) methods = { MAP, INDEX };
+            else {
+                fprintf(stderr, "ERROR: Unknown method: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'l':
+            cfg.links = splitList(optarg);
+            break;
+        case 'n':
+            cfg.events = strtoull(optarg, nullptr, 0);
+            break;
+        case 'b':
+            cfg.batch = strtoull(optarg, nullptr, 0);
+            break;
+        case 0:
+            if ( !strcmp(longOpts[opt_idx].name, "seed") ) {
+                cfg.seed = strtoull(optarg, nullptr, 0);
+            }
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if ( cfg.batch == 0 || cfg.events == 0 ) {
+        fprintf(stderr, "ERROR: --batch and --events must be greater than 0\n");
+        return -1;
+    }
+    if ( cfg.links.empty() ) {
+        cfg.links.push_back(1000);
+        cfg.links.push_back(1000000);
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    BenchConfig cfg;
+    std::vector<Method_t> methods;
+    int ret = parseCmdLine(argc, argv, cfg, methods);
+    if ( ret != 0 ) return ret < 0 ? 1 : 0;
+
+    printf("%-6s %10s %12s %10s %10s %10s %10s\n",
+           "method", "links", "events", "ns/tag", "ns/ser", "ns/lookup", "ns/event");
+    for ( auto num_links : cfg.links ) {
+        if ( num_links == 0 ) continue;
+        for ( auto method : methods ) {
+            if ( !runBenchmark(cfg, method, num_links) ) return 1;
+        }
+    }
+    return 0;
+}
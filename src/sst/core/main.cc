@@ -48,6 +48,7 @@ REENABLE_WARNING
 #include "sst/core/model/python/pymodel.h"
 #include "sst/core/memuse.h"
 #include "sst/core/iouse.h"
+#include "sst/core/threadAffinity.h"
 
 #include <sys/resource.h>
 
@@ -203,6 +204,7 @@ typedef struct {
     Config *config;
     ConfigGraph *graph;
     SimTime_t min_part;
+    int cpu;                    // cpu to pin the thread to (-1 to leave it unpinned)
 
     // Time / stats information
     double build_time;
@@ -222,6 +224,9 @@ void finalize_statEngineConfig(void)
 static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSafe::Barrier &barrier)
 {
     info.myRank.thread = tid;
+    if ( info.cpu >= 0 && !Core::bindThreadToCpu(info.cpu) ) {
+        g_output.output("WARNING: unable to pin thread %" PRIu32 " to cpu %d\n", tid, info.cpu);
+    }
     double start_build = sst_get_cpu_time();
 
     if ( tid ) {
@@ -649,11 +654,49 @@ main(int argc, char *argv[])
     Simulation::factory = factory;
     Simulation::sim_output = g_output;
     Simulation::resizeBarriers(world_size.thread);
+    if ( cfg.barrier_spin >= 0 ) Core::ThreadSafe::Barrier::setMaxSpin(cfg.barrier_spin);
     #ifdef USE_MEMPOOL
     /* Estimate that we won't have more than 128 sizes of events */
     Activity::memPools.reserve(world_size.thread * 128);
+    if ( cfg.mempool_hugepages == "transparent" ) Activity::memPoolFlags |= Core::MemPool::HUGEPAGE_TRANSPARENT;
+    else if ( cfg.mempool_hugepages == "explicit" ) Activity::memPoolFlags |= Core::MemPool::HUGEPAGE_EXPLICIT;
+    if ( cfg.mempool_numa ) Activity::memPoolFlags |= Core::MemPool::NUMA_LOCAL;
+    if ( cfg.mempool_reclaim >= 0 ) {
+        Activity::memPoolFlags |= Core::MemPool::RECLAIM;
+        Activity::memPoolReclaimReserve = cfg.mempool_reclaim;
+    }
     #endif
 
+    ////// Thread Placement //////
+    std::vector<int> threadCpus(world_size.thread, -1);
+    if ( cfg.thread_affinity != "none" ) {
+        // Count the links between each pair of this rank's threads so
+        // that compact placement can keep busy pairs on a shared cache
+        std::vector<std::vector<uint64_t>> comm(world_size.thread, std::vector<uint64_t>(world_size.thread, 0));
+        for ( auto& link : graph->getLinkMap() ) {
+            ConfigComponent* c0 = graph->findComponent(link.component[0]);
+            ConfigComponent* c1 = graph->findComponent(link.component[1]);
+            if ( nullptr == c0 || nullptr == c1 ) continue;
+            if ( c0->rank.rank != myRank.rank || c1->rank.rank != myRank.rank ) continue;
+            if ( c0->rank.thread == c1->rank.thread ) continue;
+            comm[c0->rank.thread][c1->rank.thread]++;
+            comm[c1->rank.thread][c0->rank.thread]++;
+        }
+
+        uint32_t local_rank, local_ranks;
+        Core::getNodeLocalRank(local_rank, local_ranks);
+        std::string err = Core::computeThreadPlacement(cfg.thread_affinity, world_size.thread, comm, local_rank, local_ranks, threadCpus);
+        if ( !err.empty() ) g_output.fatal(CALL_INFO, 1, "%s\n", err.c_str());
+        for ( uint32_t i = 0; i < world_size.thread; i++ ) {
+            g_output.verbose(CALL_INFO, 1, 0, "Thread %" PRIu32 " pinned to cpu %d\n", i, threadCpus[i]);
+        }
+        #ifdef USE_MEMPOOL
+        // Pinned threads stay on one node, so keep their pools there too
+        Activity::memPoolFlags |= Core::MemPool::NUMA_LOCAL;
+        #endif
+    }
+    ////// End Thread Placement //////
+
     std::vector<std::thread> threads(world_size.thread);
     std::vector<SimThreadInfo_t> threadInfo(world_size.thread);
     for ( uint32_t i = 0 ; i < world_size.thread ; i++ ) {
@@ -663,6 +706,7 @@ main(int argc, char *argv[])
         threadInfo[i].config = &cfg;
         threadInfo[i].graph = graph;
         threadInfo[i].min_part = min_part;
+        threadInfo[i].cpu = threadCpus[i];
     }
 
     double end_serial_build = sst_get_cpu_time();
@@ -814,6 +858,7 @@ main(int argc, char *argv[])
         Output out("",0,0,Output::FILE, cfg.event_dump_file);
         if ( cfg.event_dump_file == "STDOUT" || cfg.event_dump_file == "stdout" ) out.setOutputLocation(Output::STDOUT);
         if ( cfg.event_dump_file == "STDERR" || cfg.event_dump_file == "stderr" ) out.setOutputLocation(Output::STDERR);
+        Activity::printMemPoolStats("",out);
         Activity::printUndeletedActivities("",out, MAX_SIMTIME_T);
     }
 #endif
@@ -14,12 +14,21 @@
 
 #include <list>
 #include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <cinttypes>
 #include <cstdint>
 #include <sys/mman.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "sst/core/threadsafe.h"
 
@@ -49,19 +58,274 @@ class MemPool
             return p;
         }
 
+        /** Move up to count elements to the back of out */
+        inline size_t remove_bulk(std::vector<void*>& out, size_t count) {
+            std::lock_guard<LOCK_t> lock(mtx);
+            size_t n = std::min(count, list.size());
+            out.insert(out.end(), list.end() - n, list.end());
+            list.resize(list.size() - n);
+            return n;
+        }
+
+        /** Move the last count elements of in to the free list */
+        inline void insert_bulk(std::vector<void*>& in, size_t count) {
+            std::lock_guard<LOCK_t> lock(mtx);
+            list.insert(list.end(), in.end() - count, in.end());
+            in.resize(in.size() - count);
+        }
+
         size_t size() const { return list.size(); }
     };
 
+    /**
+     * Free list that keeps the free elements of each arena (slab)
+     * separately and counts the elements of each slab that are out of
+     * the list.  Elements are handed out from the lowest addressed
+     * slab first, which lets the others drain.  Once more than
+     * `reserve` slabs are completely free, further free slabs are
+     * released with madvise(MADV_DONTNEED).  Released slabs stay
+     * mapped and are reused before new arenas are mapped.  The
+     * madvise is done after the lock is dropped; the slab is not
+     * reused until it completes.
+     */
+    class SlabList {
+        struct Slab {
+            uint8_t* base;
+            /* Elements not on this slab's free list */
+            size_t inUse;
+            bool resident;
+            /* Released, but the madvise has not finished */
+            bool releasing;
+            std::vector<void*> free;
+        };
+
+        ThreadSafe::Spinlock mtx;
+        std::map<uintptr_t, Slab> slabs;
+        size_t elemSize;
+        size_t arenaSize;
+        size_t reserve;
+        /* Resident slabs with inUse == 0 */
+        size_t emptySlabs;
+        size_t numFree;
+        std::atomic<size_t> residentSlabs;
+        std::atomic<size_t> peakSlabs;
+
+        inline Slab& findSlab(void* ptr) {
+            auto it = slabs.upper_bound((uintptr_t)ptr);
+            return (--it)->second;
+        }
+
+        void fill(Slab& slab) {
+            size_t nelem = arenaSize / elemSize;
+            slab.free.reserve(nelem);
+            for ( size_t i = nelem ; i > 0 ; i-- ) {
+                slab.free.push_back(slab.base + (elemSize * (i - 1)));
+            }
+            slab.inUse = 0;
+            slab.resident = true;
+            slab.releasing = false;
+            numFree += nelem;
+            emptySlabs++;
+            size_t resident = ++residentSlabs;
+            if ( resident > peakSlabs.load() ) peakSlabs.store(resident);
+        }
+
+        inline void* take(Slab& slab) {
+            if ( slab.inUse++ == 0 ) emptySlabs--;
+            numFree--;
+            void* ptr = slab.free.back();
+            slab.free.pop_back();
+            return ptr;
+        }
+
+        /** Returns the base of the slab if it needs to be released */
+        inline uint8_t* give(void* ptr) {
+            Slab& slab = findSlab(ptr);
+            slab.free.push_back(ptr);
+            numFree++;
+            if ( --slab.inUse == 0 && ++emptySlabs > reserve ) return release(slab);
+            return nullptr;
+        }
+
+        /** Takes slab out of use.  Must be followed by
+         * finishRelease() once the lock is dropped. */
+        uint8_t* release(Slab& slab) {
+            numFree -= slab.free.size();
+            std::vector<void*>().swap(slab.free);
+            slab.resident = false;
+            slab.releasing = true;
+            emptySlabs--;
+            residentSlabs--;
+            return slab.base;
+        }
+
+        void finishRelease(uint8_t* base) {
+            madvise(base, arenaSize, MADV_DONTNEED);
+            std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+            slabs[(uintptr_t)base].releasing = false;
+        }
+
+    public:
+        SlabList(size_t elemSize, size_t arenaSize, size_t reserve) :
+            elemSize(elemSize), arenaSize(arenaSize), reserve(reserve),
+            emptySlabs(0), numFree(0), residentSlabs(0), peakSlabs(0)
+        {}
+
+        /** Add a newly mapped arena */
+        void addArena(uint8_t* base) {
+            std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+            Slab& slab = slabs[(uintptr_t)base];
+            slab.base = base;
+            fill(slab);
+        }
+
+        /** Make a released slab resident again
+         * @return the slab's base, or nullptr if there was none */
+        uint8_t* reuseArena() {
+            std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+            for ( auto& entry : slabs ) {
+                if ( !entry.second.resident && !entry.second.releasing ) {
+                    fill(entry.second);
+                    return entry.second.base;
+                }
+            }
+            return nullptr;
+        }
+
+        bool isResident(uint8_t* base) {
+            std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+            return slabs[(uintptr_t)base].resident;
+        }
+
+        inline void insert(void* ptr) {
+            uint8_t* released;
+            {
+                std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+                released = give(ptr);
+            }
+            if ( released ) finishRelease(released);
+        }
+
+        inline void* try_remove() {
+            std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+            for ( auto& entry : slabs ) {
+                if ( !entry.second.free.empty() ) return take(entry.second);
+            }
+            return nullptr;
+        }
+
+        /** Move up to count elements to the back of out */
+        size_t remove_bulk(std::vector<void*>& out, size_t count) {
+            std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+            size_t n = 0;
+            for ( auto it = slabs.begin() ; it != slabs.end() && n < count ; ++it ) {
+                Slab& slab = it->second;
+                while ( n < count && !slab.free.empty() ) {
+                    out.push_back(take(slab));
+                    n++;
+                }
+            }
+            return n;
+        }
+
+        /** Move the last count elements of in to the free list */
+        void insert_bulk(std::vector<void*>& in, size_t count) {
+            std::vector<uint8_t*> released;
+            {
+                std::lock_guard<ThreadSafe::Spinlock> lock(mtx);
+                for ( size_t i = in.size() - count ; i < in.size() ; i++ ) {
+                    uint8_t* base = give(in[i]);
+                    if ( base ) released.push_back(base);
+                }
+            }
+            in.resize(in.size() - count);
+            for ( auto* base : released ) finishRelease(base);
+        }
+
+        size_t size() const { return numFree; }
+        uint64_t getResidentBytes() const { return residentSlabs.load() * arenaSize; }
+        uint64_t getPeakBytes() const { return peakSlabs.load() * arenaSize; }
+    };
+
 
 public:
+    /**
+     * Per-thread cache of free elements for a single MemPool.
+     * Elements move between a Magazine and the pool's shared free
+     * list in bulk, so the lock is only taken once every
+     * MAGAZINE_SIZE allocations or frees.  A Magazine must only be
+     * used by the thread that created it.
+     */
+    class Magazine {
+    public:
+        Magazine(MemPool* pool) :
+            pool(pool),
+            remote(pool->owner != std::this_thread::get_id()),
+            allocs(0), frees(0)
+        {
+            items.reserve(2 * MAGAZINE_SIZE);
+            pool->attach(this);
+        }
+
+        ~Magazine()
+        {
+            pool->detach(this);
+        }
+
+        MemPool* getPool() const { return pool; }
+
+        /** True if this Magazine belongs to a thread other than the
+         * one that created the pool */
+        bool isRemote() const { return remote; }
+
+    private:
+        friend class MemPool;
+
+        /* Only the owning thread writes the counters, so they don't
+         * need atomic read-modify-write */
+        inline void count(std::atomic<uint64_t>& counter) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        MemPool* pool;
+        bool remote;
+        std::vector<void*> items;
+        std::atomic<uint64_t> allocs;
+        std::atomic<uint64_t> frees;
+    };
+
+    /** Number of elements moved between a Magazine and the pool at a time */
+    static const size_t MAGAZINE_SIZE = 64;
+
+    /** Options for allocating arenas */
+    enum ArenaFlags {
+        /** Ask for transparent huge pages (madvise) */
+        HUGEPAGE_TRANSPARENT = 0x1,
+        /** Use explicit huge pages (MAP_HUGETLB), falling back to
+         * transparent huge pages if none are available */
+        HUGEPAGE_EXPLICIT    = 0x2,
+        /** Place arenas on the NUMA node of the allocating thread */
+        NUMA_LOCAL           = 0x4,
+        /** Track per-arena usage and release completely free arenas
+         * (see SlabList) */
+        RECLAIM              = 0x8
+    };
+
     /** Create a new Memory Pool.
      * @param elementSize - Size of each Element
      * @param initialSize - Size of the memory pool (in bytes)
+     * @param arenaFlags - ArenaFlags used when allocating arenas
+     * @param reclaimReserve - With RECLAIM, number of completely free
+     *        arenas kept before arenas are released
      */
-    MemPool(size_t elementSize, size_t initialSize=(2<<20)) :
-        numAlloc(0), numFree(0),
+    MemPool(size_t elementSize, size_t initialSize=(2<<20), uint32_t arenaFlags=0, size_t reclaimReserve=0) :
+        numAlloc(0), numFree(0), numRemoteFree(0),
         elemSize(elementSize), arenaSize(initialSize),
-        allocating(false)
+        arenaFlags(arenaFlags),
+        slabList((arenaFlags & RECLAIM) ? new SlabList(elementSize, initialSize, reclaimReserve) : nullptr),
+        allocating(false), id(nextId()),
+        owner(std::this_thread::get_id()),
+        remoteFrees(nullptr)
     {
         allocPool();
     }
@@ -69,19 +333,20 @@ public:
     ~MemPool()
     {
         for ( std::list<uint8_t*>::iterator i = arenas.begin() ; i != arenas.end() ; ++i ) {
-            ::free(*i);
+            munmap(*i, arenaSize);
         }
+        delete slabList;
     }
 
     /** Allocate a new element from the memory pool */
     inline void* malloc()
     {
-        void *ret = freeList.try_remove();
+        void *ret = slabList ? slabList->try_remove() : freeList.try_remove();
         while ( !ret ) {
             bool ok = allocPool();
             if ( !ok ) return nullptr;
             sst_pause();
-            ret = freeList.try_remove();
+            ret = slabList ? slabList->try_remove() : freeList.try_remove();
         }
         ++numAlloc;
         return ret;
@@ -91,39 +356,205 @@ public:
     inline void free(void *ptr)
     {
         // TODO:  Make sure this is in one of our arenas
-        freeList.insert(ptr);
+        if ( slabList ) slabList->insert(ptr);
+        else freeList.insert(ptr);
 // #ifdef __SST_DEBUG_EVENT_TRACKING__
 //         *((uint64_t*)ptr) = 0xFFFFFFFFFFFFFFFF;
 // #endif
         ++numFree;
     }
 
+    /** Allocate a new element, using the calling thread's Magazine */
+    inline void* malloc(Magazine& mag)
+    {
+        if ( mag.items.empty() && !reclaimRemoteFrees(mag.items) ) {
+            while ( removeFree(mag.items, MAGAZINE_SIZE) == 0 ) {
+                bool ok = allocPool();
+                if ( !ok ) return nullptr;
+                sst_pause();
+            }
+        }
+        void* ret = mag.items.back();
+        mag.items.pop_back();
+        mag.count(mag.allocs);
+        return ret;
+    }
+
+    /** Return an element to the memory pool through the calling
+     * thread's Magazine */
+    inline void free(void* ptr, Magazine& mag)
+    {
+        mag.items.push_back(ptr);
+        mag.count(mag.frees);
+        if ( mag.remote ) {
+            // Remote magazines never allocate, so hand back whole
+            // batches to the owning thread.  With RECLAIM they go
+            // straight back to their slabs, so that they count as
+            // free.
+            if ( mag.items.size() >= MAGAZINE_SIZE ) {
+                if ( slabList ) insertFree(mag.items, mag.items.size());
+                else returnRemoteFrees(mag.items);
+            }
+        }
+        else if ( mag.items.size() >= 2 * MAGAZINE_SIZE ) {
+            insertFree(mag.items, MAGAZINE_SIZE);
+        }
+    }
+
+    /** Return everything cached in the calling thread's Magazine to
+     * the pool.  With RECLAIM, cached elements keep their arenas from
+     * being released, so this is called periodically. */
+    void flush(Magazine& mag)
+    {
+        if ( !mag.remote ) reclaimRemoteFrees(mag.items);
+        if ( !mag.items.empty() ) insertFree(mag.items, mag.items.size());
+    }
+
     /**
        Approximates the current memory usage of the mempool. Some
        overheads are not taken into account.
      */
     uint64_t getBytesMemUsed() {
+        if ( slabList ) {
+            return slabList->getResidentBytes() + slabList->size() * sizeof(void*);
+        }
         uint64_t bytes_in_arenas = arenas.size() * arenaSize;
         uint64_t bytes_in_free_list = freeList.size() * sizeof(void*);
         return bytes_in_arenas + bytes_in_free_list;
     }
 
+    /** Bytes of arenas currently backed by memory */
+    uint64_t getArenaBytes() {
+        return slabList ? slabList->getResidentBytes() : arenas.size() * arenaSize;
+    }
+
+    /** Largest value getArenaBytes() has had */
+    uint64_t getPeakArenaBytes() {
+        return slabList ? slabList->getPeakBytes() : arenas.size() * arenaSize;
+    }
+
+    /** False if the arena has been released back to the OS */
+    bool isArenaResident(uint8_t* arena) {
+        return slabList ? slabList->isResident(arena) : true;
+    }
+
     uint64_t getUndeletedEntries() {
-        return numAlloc - numFree;
+        uint64_t count = numAlloc - numFree;
+        std::lock_guard<std::mutex> lock(magMutex);
+        for ( auto* mag : magazines ) {
+            count += mag->allocs.load(std::memory_order_relaxed) - mag->frees.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    /**
+       Number of elements freed by the thread that created the pool
+       (local) and by other threads (remote).
+     */
+    void getFreeCounts(uint64_t& local, uint64_t& remote) {
+        remote = numRemoteFree;
+        local = numFree - remote;
+        std::lock_guard<std::mutex> lock(magMutex);
+        for ( auto* mag : magazines ) {
+            if ( mag->remote ) remote += mag->frees.load(std::memory_order_relaxed);
+            else local += mag->frees.load(std::memory_order_relaxed);
+        }
     }
 
+    /** Byte written over new arenas in debug builds */
+    static const uint8_t POISON = 0xFF;
+    /** Alignment used for transparent huge page arenas */
+    static const size_t HUGEPAGE_SIZE = (1<<21);
+
     /** Counter:  Number of times elements have been allocated */
     std::atomic<uint64_t> numAlloc;
     /** Counter:  Number times elements have been freed */
     std::atomic<uint64_t> numFree;
+    /** Counter:  Number of frees (included in numFree) made by
+     * threads other than the one that created the pool */
+    std::atomic<uint64_t> numRemoteFree;
 
     size_t getArenaSize() const { return arenaSize; }
     size_t getElementSize() const { return elemSize; }
 
     const std::list<uint8_t*>& getArenas() { return arenas; }
 
+    /** Unique, dense identifier for this pool */
+    size_t getId() const { return id; }
+
 private:
 
+    inline size_t removeFree(std::vector<void*>& out, size_t count)
+    {
+        return slabList ? slabList->remove_bulk(out, count) : freeList.remove_bulk(out, count);
+    }
+
+    inline void insertFree(std::vector<void*>& in, size_t count)
+    {
+        if ( slabList ) slabList->insert_bulk(in, count);
+        else freeList.insert_bulk(in, count);
+    }
+
+    static size_t nextId()
+    {
+        static std::atomic<size_t> next_id(0);
+        return next_id++;
+    }
+
+    void attach(Magazine* mag)
+    {
+        std::lock_guard<std::mutex> lock(magMutex);
+        magazines.push_back(mag);
+    }
+
+    /** Return a Magazine's contents and counts to the pool */
+    void detach(Magazine* mag)
+    {
+        if ( !mag->items.empty() ) insertFree(mag->items, mag->items.size());
+        std::lock_guard<std::mutex> lock(magMutex);
+        numAlloc += mag->allocs;
+        numFree += mag->frees;
+        if ( mag->remote ) numRemoteFree += mag->frees;
+        magazines.erase(std::find(magazines.begin(), magazines.end(), mag));
+    }
+
+    /* Free elements returned by other threads are chained together
+     * through the word following the pool header, which is no longer
+     * in use once the element has been freed */
+    static void*& remoteLink(void* ptr)
+    {
+        return *(((void**)ptr) + 1);
+    }
+
+    /** Push a batch of elements onto the remote free list.  Safe to
+     * call from any thread. */
+    void returnRemoteFrees(std::vector<void*>& items)
+    {
+        for ( size_t i = 1 ; i < items.size() ; i++ ) {
+            remoteLink(items[i-1]) = items[i];
+        }
+        void* first = items.front();
+        void*& last = remoteLink(items.back());
+        last = remoteFrees.load(std::memory_order_relaxed);
+        while ( !remoteFrees.compare_exchange_weak(last, first, std::memory_order_release, std::memory_order_relaxed) ) ;
+        items.clear();
+    }
+
+    /** Move everything on the remote free list to out.  Elements are
+     * only ever removed all at once, so there is no ABA problem.
+     * @return true if any elements were reclaimed */
+    bool reclaimRemoteFrees(std::vector<void*>& out)
+    {
+        if ( remoteFrees.load(std::memory_order_relaxed) == nullptr ) return false;
+        void* ptr = remoteFrees.exchange(nullptr, std::memory_order_acquire);
+        if ( ptr == nullptr ) return false;
+        while ( ptr != nullptr ) {
+            out.push_back(ptr);
+            ptr = remoteLink(ptr);
+        }
+        return true;
+    }
+
     bool allocPool()
     {
         /* If already in progress, return */
@@ -131,13 +562,33 @@ private:
             return true;
         }
 
-        uint8_t *newPool = (uint8_t*)mmap(nullptr, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
-        if ( MAP_FAILED == newPool ) {
+        uint8_t *newPool = slabList ? slabList->reuseArena() : nullptr;
+        if ( nullptr != newPool ) {
+#ifdef __SST_DEBUG_OUTPUT__
+            std::memset(newPool, POISON, arenaSize);
+#endif
+            allocating.store(0, std::memory_order_release);
+            return true;
+        }
+
+        newPool = mapArena();
+        if ( nullptr == newPool ) {
             allocating.store(0, std::memory_order_release);
             return false;
         }
-        std::memset(newPool, 0xFF, arenaSize);
+#ifdef __SST_DEBUG_OUTPUT__
+        // Poison the arena to catch use of uninitialized elements.
+        // Otherwise leave it alone: mmap returns zeroed pages, and
+        // not touching them lets them be faulted in by the thread
+        // that first uses each element.
+        std::memset(newPool, POISON, arenaSize);
+#endif
         arenas.push_back(newPool);
+        if ( slabList ) {
+            slabList->addArena(newPool);
+            allocating.store(0, std::memory_order_release);
+            return true;
+        }
         size_t nelem = arenaSize / elemSize;
         for ( size_t i = 0 ; i < nelem ; i++ ) {
             uint64_t* ptr = (uint64_t*)(newPool + (elemSize*i));
@@ -151,13 +602,86 @@ private:
         return true;
     }
 
+    /** Map a new arena according to arenaFlags
+     * @return the arena, or nullptr on failure */
+    uint8_t* mapArena()
+    {
+        uint8_t* arena = nullptr;
+#ifdef MAP_HUGETLB
+        if ( arenaFlags & HUGEPAGE_EXPLICIT ) {
+            void* ptr = mmap(nullptr, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_HUGETLB, -1, 0);
+            if ( MAP_FAILED != ptr ) arena = (uint8_t*)ptr;
+            // No huge pages reserved; don't try again
+            else arenaFlags = (arenaFlags & ~HUGEPAGE_EXPLICIT) | HUGEPAGE_TRANSPARENT;
+        }
+#endif
+        if ( nullptr == arena && (arenaFlags & HUGEPAGE_TRANSPARENT) ) {
+            // Transparent huge pages need a huge page aligned region,
+            // so map extra and trim the ends
+            const size_t align = HUGEPAGE_SIZE;
+            void* ptr = mmap(nullptr, arenaSize + align, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if ( MAP_FAILED == ptr ) return nullptr;
+            uintptr_t start = ((uintptr_t)ptr + align - 1) & ~(uintptr_t)(align - 1);
+            size_t head = start - (uintptr_t)ptr;
+            if ( head ) munmap(ptr, head);
+            if ( align - head ) munmap((void*)(start + arenaSize), align - head);
+            arena = (uint8_t*)start;
+#ifdef MADV_HUGEPAGE
+            madvise(arena, arenaSize, MADV_HUGEPAGE);
+#endif
+        }
+        if ( nullptr == arena ) {
+            void* ptr = mmap(nullptr, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if ( MAP_FAILED == ptr ) return nullptr;
+            arena = (uint8_t*)ptr;
+        }
+        if ( arenaFlags & NUMA_LOCAL ) bindToLocalNode(arena);
+        return arena;
+    }
+
+    /** Ask the kernel to place the pages of arena on the NUMA node the
+     * calling thread is running on.  Must be called before the pages
+     * are touched.  Uses a preferred rather than strict policy so
+     * allocation still succeeds when the node is out of memory. */
+    void bindToLocalNode(uint8_t* arena)
+    {
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+        unsigned cpu = 0, node = 0;
+        if ( syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 ) return;
+        const int MPOL_PREFERRED_MODE = 1;
+        const size_t bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> mask(node / bits + 1, 0);
+        mask[node / bits] = 1UL << (node % bits);
+        syscall(SYS_mbind, arena, arenaSize, MPOL_PREFERRED_MODE, mask.data(), mask.size() * bits + 1, 0);
+#else
+        (void)arena;
+#endif
+    }
+
     size_t elemSize;
     size_t arenaSize;
+    uint32_t arenaFlags;
+    /* Used in place of freeList with RECLAIM */
+    SlabList* slabList;
 
     std::atomic<unsigned int> allocating;
     FreeList<ThreadSafe::Spinlock> freeList;
     std::list<uint8_t*> arenas;
 
+    size_t id;
+    std::mutex magMutex;
+    std::vector<Magazine*> magazines;
+
+    /* Thread that created the pool; its magazine reclaims remoteFrees */
+    std::thread::id owner;
+    /* remoteFrees is written by other threads, so keep it on its own
+     * cache line.  Padded rather than aligned, since pools are created
+     * with plain new, which does not honour over-alignment before
+     * C++17. */
+    char remotePadBefore[64];
+    std::atomic<void*> remoteFrees;
+    char remotePadAfter[64 - sizeof(std::atomic<void*>)];
+
 };
 
 }
@@ -76,6 +76,7 @@ public:  /* Public, but private.  Called only from Python functions */
     
     void addLink(ComponentId_t id, const char *link_name, const char *port, const char *latency, bool no_cut) const {graph->addLink(id, link_name, port, latency, no_cut); }
     void setLinkNoCut(const char *link_name) const {graph->setLinkNoCut(link_name); }
+    void setLinkCoalesce(const char *link_name) const {graph->setLinkCoalesce(link_name); }
     
     void pushNamePrefix(const char *name);
     void popNamePrefix(void);
@@ -206,6 +206,7 @@ static PyObject* compAddLink(PyObject *self, PyObject *args)
 
     gModel->getOutput()->verbose(CALL_INFO, 4, 0, "Connecting component %" PRIu64 " to Link %s (lat: %s)\n", id, link->name, lat);
     gModel->addLink(id, link->name, port, lat, link->no_cut);
+    if ( link->coalesce ) gModel->setLinkCoalesce(link->name);
 
     return SST_ConvertToPythonLong(0);
 }
@@ -43,6 +43,7 @@ static int linkInit(LinkPy_t *self, PyObject *args, PyObject *UNUSED(kwds))
 
     self->name = gModel->addNamePrefix(name);
     self->no_cut = false;
+    self->coalesce = false;
     self->latency = lat ? strdup(lat) : nullptr;
     gModel->getOutput()->verbose(CALL_INFO, 3, 0, "Creating Link %s\n", self->name);
 
@@ -107,6 +108,7 @@ static PyObject* linkConnect(PyObject* self, PyObject *args)
             id0, id1, ((LinkPy_t*)self)->name, lat0, lat1);
     gModel->addLink(id0, link->name, port0, lat0, link->no_cut);
     gModel->addLink(id1, link->name, port1, lat1, link->no_cut);
+    if ( link->coalesce ) gModel->setLinkCoalesce(link->name);
 
 
     return SST_ConvertToPythonLong(0);
@@ -123,6 +125,16 @@ static PyObject* linkSetNoCut(PyObject* self, PyObject *UNUSED(args))
 }
 
 
+static PyObject* linkSetCoalesce(PyObject* self, PyObject *UNUSED(args))
+{
+    LinkPy_t *link = (LinkPy_t*)self;
+    bool prev = link->coalesce;
+    link->coalesce = true;
+    gModel->setLinkCoalesce(link->name);
+    return PyBool_FromLong(prev ? 1 : 0);
+}
+
+
 
 
 static PyMethodDef linkMethods[] = {
@@ -132,6 +144,9 @@ static PyMethodDef linkMethods[] = {
     {   "setNoCut",
         linkSetNoCut, METH_NOARGS,
         "Specifies that this link should not be partitioned across"},
+    {   "setCoalesce",
+        linkSetCoalesce, METH_NOARGS,
+        "Specifies that events sent on this link during one time step for the same delivery time should be merged.  Events are only merged if the event class overrides Event::merge(); each merge removes a call to the receiving handler."},
     {   nullptr, nullptr, 0, nullptr }
 };
 
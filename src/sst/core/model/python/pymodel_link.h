@@ -23,6 +23,7 @@ struct LinkPy_t {
     PyObject_HEAD
     char *name;
     bool no_cut;
+    bool coalesce;
     char *latency;
 };
 
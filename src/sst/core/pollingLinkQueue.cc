@@ -16,44 +16,74 @@
 
 namespace SST {
 
-    PollingLinkQueue::PollingLinkQueue() : ActivityQueue() {}
+    PollingLinkQueue::PollingLinkQueue() :
+        ActivityQueue(),
+        data(16, nullptr),
+        head(0),
+        count(0)
+    {}
+
     PollingLinkQueue::~PollingLinkQueue() {
     // Need to delete any events left in the queue
-    std::multiset<Activity*,Activity::less_time>::iterator it;
-    for ( it = data.begin(); it != data.end(); ++it ) {
-        delete *it;
+    size_t mask = data.size() - 1;
+    for ( size_t i = 0; i < count; i++ ) {
+        delete data[(head + i) & mask];
     }
-    data.clear();
+    count = 0;
     }
 
     bool PollingLinkQueue::empty()
     {
-    return data.empty();
+    return count == 0;
     }
 
     int PollingLinkQueue::size()
     {
-    return data.size();
+    return count;
     }
 
     void PollingLinkQueue::insert(Activity* activity)
     {
-    data.insert(activity);
+    if ( count == data.size() ) grow();
+    size_t mask = data.size() - 1;
+
+    // Move later activities up one slot until the new one is in
+    // order.  Usually there are none.
+    size_t pos = count;
+    SimTime_t time = activity->getDeliveryTime();
+    while ( pos > 0 && data[(head + pos - 1) & mask]->getDeliveryTime() > time ) {
+        data[(head + pos) & mask] = data[(head + pos - 1) & mask];
+        pos--;
+    }
+    data[(head + pos) & mask] = activity;
+    count++;
     }
 
     Activity* PollingLinkQueue::pop()
     {
-    if ( data.size() == 0 ) return nullptr;
-    std::multiset<Activity*,Activity::less_time>::iterator it = data.begin();
-    Activity* ret_val = (*it);
-    data.erase(it);
+    if ( count == 0 ) return nullptr;
+    Activity* ret_val = data[head];
+    head = (head + 1) & (data.size() - 1);
+    count--;
     return ret_val;
     }
 
     Activity* PollingLinkQueue::front()
     {
-    if ( data.size() == 0 ) return nullptr;
-    return *data.begin();
+    if ( count == 0 ) return nullptr;
+    return data[head];
+    }
+
+    void PollingLinkQueue::grow()
+    {
+    // Unwrap the ring into the front of the new storage
+    std::vector<Activity*> new_data(data.size() * 2, nullptr);
+    size_t mask = data.size() - 1;
+    for ( size_t i = 0; i < count; i++ ) {
+        new_data[i] = data[(head + i) & mask];
+    }
+    data.swap(new_data);
+    head = 0;
     }
 
 
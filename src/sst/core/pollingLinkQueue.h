@@ -12,7 +12,7 @@
 #ifndef SST_CORE_POLLINGLINKQUEUE_H
 #define SST_CORE_POLLINGLINKQUEUE_H
 
-#include <set>
+#include <vector>
 
 #include "sst/core/activityQueue.h"
 
@@ -20,6 +20,12 @@ namespace SST {
 
 /**
  * A link queue which is used for polling only.
+ *
+ * Events on a link almost always arrive in delivery time order, so
+ * they are kept in a ring buffer that grows as needed.  An event that
+ * arrives out of order is moved back past the later ones.  Events
+ * with the same delivery time come out in the order they were
+ * inserted.
  */
 class PollingLinkQueue : public ActivityQueue {
 public:
@@ -34,7 +40,15 @@ public:
 
 
 private:
-    std::multiset<Activity*,Activity::less_time> data;
+    /** Double the capacity of the ring */
+    void grow();
+
+    /** Storage for the ring; the size is always a power of two */
+    std::vector<Activity*> data;
+    /** Index of the first activity */
+    size_t head;
+    /** Number of activities in the ring */
+    size_t count;
 
 };
 
@@ -75,6 +75,11 @@ RankSyncParallelSkip::~RankSyncParallelSkip()
     }
     link_map.clear();
 
+    for ( auto* queue : link_queues ) {
+        delete queue;
+    }
+    link_queues.clear();
+
     delete[] recv_count;
     delete[] link_send_queue;
 
@@ -90,7 +95,6 @@ ActivityQueue* RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const
         send_count++;
         comm_send_map[to_rank].to_rank = to_rank;
         queue = comm_send_map[to_rank].squeue = new SyncQueue();
-        comm_send_map[to_rank].remote_size = 4096;
     } else {
         queue = comm_send_map[to_rank].squeue;
     }
@@ -107,6 +111,8 @@ ActivityQueue* RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const
         comm_recv_map[remote_rank_local_thread].local_size = 4096;
     }
 
+    comm_send_map[to_rank].links.push_back(link);
+    comm_recv_map[remote_rank_local_thread].links.push_back(link);
     link_map[link_id] = link;
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     link->setSendingComponentInfo("SYNC", "SYNC", "");
@@ -120,6 +126,22 @@ RankSyncParallelSkip::finalizeLinkConfigurations() {
         finalizeConfiguration(i->second);
     }
 
+    // Events sent during run carry the index of their Link instead of
+    // its id.  The Links sent to one remote thread are the same set the
+    // remote thread receives from this rank.
+    for ( auto& peer : comm_send_map ) {
+        std::vector<Link*>& links = peer.second.links;
+        sortLinksById(links);
+        for ( size_t i = 0; i < links.size(); i++ ) {
+            RankSyncLinkQueue* queue = new RankSyncLinkQueue(peer.second.squeue, i);
+            link_queues.push_back(queue);
+            setRecvQueue(links[i], queue);
+        }
+    }
+    for ( auto& peer : comm_recv_map ) {
+        sortLinksById(peer.second.links);
+    }
+
     // Set the size of the BoundedQueue that is the work queue for
     // serializations
     deserialize_queue.initialize(comm_recv_map.size());
@@ -179,11 +201,6 @@ RankSyncParallelSkip::exchange_slave(int thread)
 
     int my_recv_count = recv_count[thread];
 
-    // Do nothing until there are events to be sent on this thread's
-    // links
-    Simulation* sim = Simulation::getSimulation();
-    SimTime_t current_cycle = sim->getCurrentSimCycle();
-
     // Two things left to do.  Deserialize receives and send
     // deserialized events on the proper link.  Will preferentially
     // send first.
@@ -195,18 +212,7 @@ RankSyncParallelSkip::exchange_slave(int thread)
             // comm_recv_pair* recv = link_send_queue[thread].remove();
             my_recv_count--;
 
-            for ( size_t i = 0; i < recv->activity_vec.size(); i++ ) {
-                Event* ev = static_cast<Event*>(recv->activity_vec[i]);
-                link_map_t::iterator link = link_map.find(ev->getLinkId());
-                if (link == link_map.end()) {
-                    Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
-                } else {
-                    // Need to figure out what the "delay" is for this event.
-                    SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-                    link->second->send(delay,ev);
-                }
-            }
-            recv->activity_vec.clear();
+            deliverEvents(recv->activity_vec, recv->links, recv->remote_rank);
         }
         else if ( deserialize_queue.try_remove(recv) ) {
             remaining_deser--;
@@ -223,9 +229,8 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
 {
 #ifdef SST_CONFIG_HAVE_MPI
 
-    //Maximum number of outstanding requests is 3 times the number
-    // of ranks I communicate with (1 recv, 2 sends per rank)
-    MPI_Request sreqs[2 * comm_send_map.size()];
+    // One send per rank/thread pair I communicate with
+    MPI_Request sreqs[comm_send_map.size()];
     int sreq_count = 0;
 
     // First thing to do is fill the serialize_queue.
@@ -238,11 +243,7 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
     serializeReadyBarrier.wait(); /* Wait for / release slaves to serialize */
 
     for (auto i = comm_recv_map.begin() ; i != comm_recv_map.end() ; ++i) {
-        // Post all the receives
-        int tag = 2 * i->second.local_thread;
         i->second.recv_done = false;
-        MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                  i->second.remote_rank, tag, MPI_COMM_WORLD, &i->second.req);
     }
 
     // Do all the sends, but if there are no sends to do, then help
@@ -256,19 +257,7 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
             char* send_buffer = send->sbuf;
             // Cast to Header so we can get/fill in data
             SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
-            int tag = 2 * send->to_rank.thread;
-            // Check to see if remote queue is big enough for data
-            if ( send->remote_size < hdr->buffer_size ) {
-                // not big enough, send message that will tell remote side to get larger buffer
-                hdr->mode = 1;
-                MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
-                          send->to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-                send->remote_size = hdr->buffer_size;
-                tag = 2 * send->to_rank.thread + 1;
-            }
-            else {
-                hdr->mode = 0;
-            }
+            int tag = send->to_rank.thread;
             MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE,
                       send->to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
         }
@@ -283,37 +272,16 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
         }
     }
 
-    // Do all the receives as they arrive
+    // Do all the receives as they arrive.  Each buffer is resized to
+    // fit its message when it is matched.
     int receives_to_process = comm_recv_map.size();
     while ( receives_to_process != 0 ) {
         for (auto i = comm_recv_map.begin() ; i != comm_recv_map.end() ; ++i) {
             if ( !i->second.recv_done ) {
-                int flag;
-                MPI_Test(&i->second.req, &flag , MPI_STATUS_IGNORE);
-                if ( flag ) {
+                if ( tryRecvSyncBuffer(i->second.remote_rank, i->second.local_thread,
+                                       i->second.rbuf, i->second.local_size) ) {
                     receives_to_process--;
                     i->second.recv_done = true;
-
-                    // Get the buffer and deserialize all the events
-                    char* buffer = i->second.rbuf;
-
-                    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
-                    unsigned int size = hdr->buffer_size;
-                    int mode = hdr->mode;
-
-                    if ( mode == 1 ) {
-                        // May need to resize the buffer
-                        if ( size > i->second.local_size ) {
-                            delete[] i->second.rbuf;
-                            i->second.rbuf = new char[size];
-                            i->second.local_size = size;
-                        }
-                        MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                                 i->second.remote_rank, 2 * i->second.local_thread + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                        buffer = i->second.rbuf;
-
-                    }
-
                     deserialize_queue.try_insert(&(i->second));
                 }
             }
@@ -339,8 +307,7 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
     // Need to get the local minimum, then do a global minimum
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
     SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
-    SimTime_t min_time;
-    MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
+    SimTime_t min_time = reduceNextActivityAndExit(input);
 
     myNextSyncTime = min_time + max_period->getFactor();
 
@@ -354,20 +321,10 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
     if ( thread != 0 ) {
         return;
     }
-    //Maximum number of outstanding requests is 3 times the number
-    // of ranks I communicate with (1 recv, 2 sends per rank)
-    MPI_Request sreqs[2 * comm_send_map.size()];
-    MPI_Request rreqs[comm_recv_map.size()];
-    int rreq_count = 0;
+    // One send per rank/thread pair I communicate with
+    MPI_Request sreqs[comm_send_map.size()];
     int sreq_count = 0;
 
-    for ( auto i = comm_recv_map.begin(); i != comm_recv_map.end(); ++i ) {
-        // Post all the receives
-        int tag = 2 * i->second.local_thread;
-        MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                  i->second.remote_rank, tag, MPI_COMM_WORLD, &rreqs[rreq_count++]);
-    }
-
     for (auto i = comm_send_map.begin() ; i != comm_send_map.end() ; ++i) {
 
         // Do all the sends
@@ -375,48 +332,23 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
         char* send_buffer = i->second.squeue->getData();
         // Cast to Header so we can get/fill in data
         SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
-        int tag = 2 * i->second.to_rank.thread;
-        // Check to see if remote queue is big enough for data
-        if ( i->second.remote_size < hdr->buffer_size ) {
-            // not big enough, send message that will tell remote side to get larger buffer
-            hdr->mode = 1;
-            MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
-                      i->second.to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
-            tag = 2 * i->second.to_rank.thread + 1;
-        }
-        else {
-            hdr->mode = 0;
-        }
+        int tag = i->second.to_rank.thread;
         MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE,
                   i->second.to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
 
 
     }
 
-    // Wait for all recvs to complete
-    MPI_Waitall(rreq_count, rreqs, MPI_STATUSES_IGNORE);
-
     for (auto i = comm_recv_map.begin() ; i != comm_recv_map.end() ; ++i) {
 
-        // Get the buffer and deserialize all the events
+        // Receive the buffer, resized to fit the message if needed
+        recvSyncBuffer(i->second.remote_rank, i->second.local_thread, i->second.rbuf, i->second.local_size);
+
+        // Deserialize all the events
         char* buffer = i->second.rbuf;
 
         SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
         unsigned int size = hdr->buffer_size;
-        int mode = hdr->mode;
-
-        if ( mode == 1 ) {
-            // May need to resize the buffer
-            if ( size > i->second.local_size ) {
-                delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
-            }
-            MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                     i->second.remote_rank, 2 * i->second.local_thread + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            buffer = i->second.rbuf;
-        }
 
         SST::Core::Serialization::serializer ser;
         ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
@@ -18,6 +18,7 @@
 #include "sst/core/warnmacros.h"
 
 #include <map>
+#include <vector>
 
 #ifdef SST_CONFIG_HAVE_MPI
 DISABLE_WARN_MISSING_OVERRIDE
@@ -51,6 +52,8 @@ public:
 
     uint64_t getDataSize() const override;
 
+    bool reducesExit() const override { return true; }
+
 private:
 
     static SimTime_t myNextSyncTime;
@@ -63,7 +66,8 @@ private:
         RankInfo to_rank;
         SyncQueue* squeue; // SyncQueue
         char* sbuf;
-        uint32_t remote_size;
+        // Links to to_rank, in the order of the remote table
+        std::vector<Link*> links;
     };
 
     struct comm_recv_pair {
@@ -73,9 +77,8 @@ private:
         std::vector<Activity*> activity_vec;
         uint32_t local_size;
         bool recv_done;
-#ifdef SST_CONFIG_HAVE_MPI
-        MPI_Request req;
-#endif
+        // Links from remote_rank, indexed by the id carried in the events
+        std::vector<Link*> links;
     };
 
     typedef std::map<RankInfo, comm_send_pair > comm_send_map_t;
@@ -86,6 +89,7 @@ private:
     comm_send_map_t comm_send_map;
     comm_recv_map_t comm_recv_map;
     link_map_t link_map;
+    std::vector<ActivityQueue*> link_queues;
 
     double mpiWaitTime;
     double deserializeTime;
@@ -22,6 +22,9 @@
 #include "sst/core/timeConverter.h"
 #include "sst/core/profile.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "sst/core/warnmacros.h"
 #ifdef SST_CONFIG_HAVE_MPI
 DISABLE_WARN_MISSING_OVERRIDE
@@ -38,14 +41,30 @@ namespace SST {
 // Static Data Members
 SimTime_t RankSyncSerialSkip::myNextSyncTime = 0;
 
+// Size of each slot in the shared memory windows, including the size
+// field at its start
+static const size_t SHM_SLOT_SIZE = 64 * 1024;
+
 
-RankSyncSerialSkip::RankSyncSerialSkip(TimeConverter* UNUSED(minPartTC)) :
+RankSyncSerialSkip::RankSyncSerialSkip(TimeConverter* UNUSED(minPartTC), Mode_t mode) :
     NewRankSync(),
     mpiWaitTime(0.0),
-    deserializeTime(0.0)
+    deserializeTime(0.0),
+    pipelined(mode == PIPELINED),
+    shared(mode == SHARED),
+    in_flight(false),
+    mpiOverlapTime(0.0),
+    exchanges(0),
+    exchangesHidden(0),
+    reduced_min(0)
 {
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
+    if ( pipelined ) {
+        // Events sent before the first sync are at least a lookahead
+        // out, so they can be delivered at the second
+        myNextSyncTime = std::max<SimTime_t>(1, (max_period->getFactor() + 1) / 2);
+    }
 }
 
 RankSyncSerialSkip::~RankSyncSerialSkip()
@@ -60,7 +79,16 @@ RankSyncSerialSkip::~RankSyncSerialSkip()
     }
     link_map.clear();
 
-    if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 )
+    for ( auto* queue : link_queues ) {
+        delete queue;
+    }
+    link_queues.clear();
+
+    if ( pipelined ) {
+        if ( exchanges > 0 )
+            Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip (pipelined) mpiWait: %lg sec  mpiOverlap: %lg sec  hidden exchanges: %" PRIu64 " of %" PRIu64 "  deserializeWait:  %lg sec\n", mpiWaitTime, mpiOverlapTime, exchangesHidden, exchanges, deserializeTime);
+    }
+    else if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 )
         Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip mpiWait: %lg sec  deserializeWait:  %lg sec\n", mpiWaitTime, deserializeTime);
 }
 
@@ -71,11 +99,13 @@ ActivityQueue* RankSyncSerialSkip::registerLink(const RankInfo& to_rank, const R
         queue = comm_map[to_rank.rank].squeue = new SyncQueue();
         comm_map[to_rank.rank].rbuf = new char[4096];
         comm_map[to_rank.rank].local_size = 4096;
-        comm_map[to_rank.rank].remote_size = 4096;
+        comm_map[to_rank.rank].shm_send = nullptr;
+        comm_map[to_rank.rank].shm_recv = nullptr;
     } else {
         queue = comm_map[to_rank.rank].squeue;
     }
 
+    comm_map[to_rank.rank].links.push_back(link);
     link_map[link_id] = link;
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     link->setSendingComponentInfo("SYNC", "SYNC", "");
@@ -88,10 +118,105 @@ RankSyncSerialSkip::finalizeLinkConfigurations() {
     for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
         finalizeConfiguration(i->second);
     }
+
+    // Events sent during run carry the index of their Link instead of
+    // its id
+    for ( auto& peer : comm_map ) {
+        std::vector<Link*>& links = peer.second.links;
+        sortLinksById(links);
+        for ( size_t j = 0; j < links.size(); j++ ) {
+            RankSyncLinkQueue* queue = new RankSyncLinkQueue(peer.second.squeue, j);
+            link_queues.push_back(queue);
+            setRecvQueue(links[j], queue);
+        }
+    }
+
+    if ( shared ) setupSharedMemory();
+}
+
+void
+RankSyncSerialSkip::setupSharedMemory()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+
+    MPI_Group world_group;
+    MPI_Group node_group;
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Comm_group(node_comm, &node_group);
+
+    // Find which peers are on this node
+    std::vector<comm_pair*> local_peers;
+    std::vector<int> node_ranks;
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        int world_rank = i->first;
+        int node_rank;
+        MPI_Group_translate_ranks(world_group, 1, &world_rank, node_group, &node_rank);
+        if ( node_rank == MPI_UNDEFINED ) continue;
+        local_peers.push_back(&i->second);
+        node_ranks.push_back(node_rank);
+    }
+    MPI_Group_free(&world_group);
+    MPI_Group_free(&node_group);
+
+    char* base;
+    MPI_Win_allocate_shared(local_peers.size() * SHM_SLOT_SIZE, 1, MPI_INFO_NULL, node_comm, &base, &shm_win);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, shm_win);
+
+    // Each peer is told which slot in my window is theirs
+    std::vector<int> send_slot(local_peers.size());
+    std::vector<int> recv_slot(local_peers.size());
+    std::vector<MPI_Request> reqs(2 * local_peers.size());
+    for ( size_t j = 0; j < local_peers.size(); j++ ) {
+        send_slot[j] = j;
+        local_peers[j]->shm_send = base + j * SHM_SLOT_SIZE;
+        MPI_Isend(&send_slot[j], 1, MPI_INT, node_ranks[j], 2, node_comm, &reqs[2 * j]);
+        MPI_Irecv(&recv_slot[j], 1, MPI_INT, node_ranks[j], 2, node_comm, &reqs[2 * j + 1]);
+    }
+    MPI_Waitall(reqs.size(), reqs.data(), MPI_STATUSES_IGNORE);
+
+    for ( size_t j = 0; j < local_peers.size(); j++ ) {
+        MPI_Aint size;
+        int disp_unit;
+        char* remote;
+        MPI_Win_shared_query(shm_win, node_ranks[j], &size, &disp_unit, &remote);
+        local_peers[j]->shm_recv = remote + recv_slot[j] * SHM_SLOT_SIZE;
+    }
+#endif
+}
+
+void
+RankSyncSerialSkip::freeSharedMemory()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        i->second.shm_send = nullptr;
+        i->second.shm_recv = nullptr;
+    }
+    MPI_Win_unlock_all(shm_win);
+    MPI_Win_free(&shm_win);
+    MPI_Comm_free(&node_comm);
+#endif
 }
 
 void
 RankSyncSerialSkip::prepareForComplete() {
+#ifdef SST_CONFIG_HAVE_MPI
+    // The untimed exchange reuses tag 1, so the last pipelined
+    // exchange has to be finished first.  The simulation is over, so
+    // whatever it carried is dropped.
+    if ( in_flight ) {
+        size_t j = 0;
+        for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+            waitPipelinedRecv(i, j++);
+        }
+        MPI_Waitall(sreqs.size(), sreqs.data(), MPI_STATUSES_IGNORE);
+        finishReduceNextActivityAndExit();
+        in_flight = false;
+    }
+#endif
+    if ( shared ) freeSharedMemory();
+
     for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
         prepareForCompleteInt(i->second);
     }
@@ -119,13 +244,14 @@ void
 RankSyncSerialSkip::exchange(void)
 {
 #ifdef SST_CONFIG_HAVE_MPI
+    if ( pipelined ) {
+        exchangePipelined();
+        return;
+    }
 
-    //Maximum number of outstanding requests is 3 times the number
-    // of ranks I communicate with (1 recv, 2 sends per rank)
-    MPI_Request sreqs[2 * comm_map.size()];
-    MPI_Request rreqs[comm_map.size()];
+    // One send per rank I communicate with
+    MPI_Request sreqs[comm_map.size()];
     int sreq_count = 0;
-    int rreq_count = 0;
 
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
 
@@ -135,54 +261,47 @@ RankSyncSerialSkip::exchange(void)
         // Cast to Header so we can get/fill in data
         SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
         // Simulation::getSimulation()->getSimulationOutput().output("Data size = %d\n", hdr->buffer_size);
-        int tag = 1;
-        // Check to see if remote queue is big enough for data
-        if ( i->second.remote_size < hdr->buffer_size ) {
-            // not big enough, send message that will tell remote side to get larger buffer
-            hdr->mode = 1;
-            MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
-                      i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
-            tag = 2;
-        }
-        else {
-            hdr->mode = 0;
+        if ( i->second.shm_send != nullptr ) {
+            // The slot starts with the size, which also tells the peer
+            // whether to look for the buffer over MPI instead
+            *reinterpret_cast<uint64_t*>(i->second.shm_send) = hdr->buffer_size;
+            if ( hdr->buffer_size <= SHM_SLOT_SIZE - sizeof(uint64_t) ) {
+                memcpy(i->second.shm_send + sizeof(uint64_t), send_buffer, hdr->buffer_size);
+                continue;
+            }
         }
         MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE,
-                  i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-
-        // Post all the receives
-        MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                  i->first, 1, MPI_COMM_WORLD, &rreqs[rreq_count++]);
+                  i->first/*dest*/, 1, MPI_COMM_WORLD, &sreqs[sreq_count++]);
     }
 
-    // Wait for all sends and recvs to complete
-    Simulation* sim = Simulation::getSimulation();
-    SimTime_t current_cycle = sim->getCurrentSimCycle();
-
-    auto waitStart = SST::Core::Profile::now();
-    MPI_Waitall(rreq_count, rreqs, MPI_STATUSES_IGNORE);
-    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+    if ( shared ) {
+        // Make the slots written above visible to the other ranks on
+        // the node, and theirs to me
+        auto waitStart = SST::Core::Profile::now();
+        MPI_Win_sync(shm_win);
+        MPI_Barrier(node_comm);
+        MPI_Win_sync(shm_win);
+        mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+    }
 
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
-        // Get the buffer and deserialize all the events
-        char* buffer = i->second.rbuf;
+        char* buffer;
+        if ( i->second.shm_recv != nullptr &&
+             *reinterpret_cast<uint64_t*>(i->second.shm_recv) <= SHM_SLOT_SIZE - sizeof(uint64_t) ) {
+            // Deserialize straight out of the peer's window
+            buffer = i->second.shm_recv + sizeof(uint64_t);
+        }
+        else {
+            // Receive the buffer, resized to fit the message if needed
+            auto waitStart = SST::Core::Profile::now();
+            recvSyncBuffer(i->first, 1, i->second.rbuf, i->second.local_size);
+            mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+            buffer = i->second.rbuf;
+        }
 
+        // Deserialize all the events
         SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
         unsigned int size = hdr->buffer_size;
-        int mode = hdr->mode;
-
-        if ( mode == 1 ) {
-            // May need to resize the buffer
-            if ( size > i->second.local_size ) {
-                delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
-            }
-            MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                     i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            buffer = i->second.rbuf;
-        }
 
         auto deserialStart = SST::Core::Profile::now();
 
@@ -195,25 +314,13 @@ RankSyncSerialSkip::exchange(void)
 
         deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
 
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-
-            Event* ev = static_cast<Event*>(activities[j]);
-            link_map_t::iterator link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
-            } else {
-                // Need to figure out what the "delay" is for this event.
-                SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-                link->second->send(delay,ev);
-            }
-        }
-
+        deliverEvents(activities, i->second.links, i->first);
         activities.clear();
 
     }
 
     // Clear the SyncQueues used to send the data after all the sends have completed
-    waitStart = SST::Core::Profile::now();
+    auto waitStart = SST::Core::Profile::now();
     MPI_Waitall(sreq_count, sreqs, MPI_STATUSES_IGNORE);
     mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
 
@@ -231,13 +338,180 @@ RankSyncSerialSkip::exchange(void)
     // Need to get the local minimum, then do a global minimum
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
     SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
-    SimTime_t min_time;
-    MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
+    SimTime_t min_time = reduceNextActivityAndExit(input);
 
     myNextSyncTime = min_time + max_period->getFactor();
 #endif
 }
 
+void
+RankSyncSerialSkip::exchangePipelined()
+{
+    if ( in_flight ) completeExchange();
+
+    // Nothing can be sent after this sync that arrives earlier than a
+    // lookahead past the minimum reduced with the previous exchange
+    SimTime_t lookahead = max_period->getFactor();
+    SimTime_t next = MAX_SIMTIME_T;
+    if ( reduced_min <= MAX_SIMTIME_T - lookahead ) next = reduced_min + lookahead;
+    myNextSyncTime = std::max(Simulation::getSimulation()->getCurrentSimCycle(), next);
+
+    postExchange();
+}
+
+void
+RankSyncSerialSkip::postExchange()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    sreqs.clear();
+    // The receives are started by exchangeDone() once each buffer has
+    // been matched, when its size is known
+    rreqs.assign(comm_map.size(), MPI_REQUEST_NULL);
+    recv_started.assign(comm_map.size(), false);
+
+    // Events that are still in flight have not reached any
+    // TimeVortex, so they count toward the minimum as well
+    SimTime_t min_input = Simulation::getLocalMinimumNextActivityTime();
+
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        comm_pair& pair = i->second;
+
+        char* send_buffer = pair.squeue->getData();
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
+        if ( pair.squeue->getDataMinTime() < min_input ) min_input = pair.squeue->getDataMinTime();
+
+        sreqs.emplace_back();
+        MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE,
+                  i->first/*dest*/, 1, MPI_COMM_WORLD, &sreqs.back());
+    }
+
+    // The Exit state goes along with the minimum, and so also takes
+    // effect at the next sync
+    startReduceNextActivityAndExit(min_input);
+    in_flight = true;
+    exchanges++;
+    post_time = SST::Core::Profile::now();
+#endif
+}
+
+bool
+RankSyncSerialSkip::exchangeDone()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    // Start the receives for any buffers that have been matched, so
+    // that the rest of them can arrive while the simulation runs
+    bool done = true;
+    size_t j = 0;
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        if ( !startPipelinedRecv(i, j++, false) ) done = false;
+    }
+    if ( !done ) return false;
+
+    int flag;
+    MPI_Testall(sreqs.size(), sreqs.data(), &flag, MPI_STATUSES_IGNORE);
+    if ( !flag ) return false;
+    MPI_Testall(rreqs.size(), rreqs.data(), &flag, MPI_STATUSES_IGNORE);
+    if ( !flag ) return false;
+    return testReduceNextActivityAndExit();
+#else
+    return true;
+#endif
+}
+
+void
+RankSyncSerialSkip::completeExchange()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    // If the exchange had already finished, it may have taken much
+    // less time than the simulation ran, so only exchanges that are
+    // still going count toward the overlap
+    double running = SST::Core::Profile::getElapsed(post_time);
+    if ( exchangeDone() ) exchangesHidden++;
+    else mpiOverlapTime += running;
+
+    size_t j = 0;
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        auto waitStart = SST::Core::Profile::now();
+        char* buffer = waitPipelinedRecv(i, j++);
+        mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+        unsigned int size = hdr->buffer_size;
+
+        auto deserialStart = SST::Core::Profile::now();
+
+        SST::Core::Serialization::serializer ser;
+        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
+
+        std::vector<Activity*> activities;
+        ser & activities;
+
+        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+
+        deliverEvents(activities, i->second.links, i->first);
+    }
+
+    // The send buffers are reused by the next getData()
+    auto waitStart = SST::Core::Profile::now();
+    MPI_Waitall(sreqs.size(), sreqs.data(), MPI_STATUSES_IGNORE);
+    reduced_min = finishReduceNextActivityAndExit();
+    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    in_flight = false;
+#endif
+}
+
+bool
+RankSyncSerialSkip::startPipelinedRecv(comm_map_t::iterator UNUSED_WO_MPI(peer), size_t UNUSED_WO_MPI(index), bool UNUSED_WO_MPI(block))
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( recv_started[index] ) return true;
+
+    MPI_Message msg;
+    MPI_Status status;
+    if ( block ) {
+        MPI_Mprobe(peer->first, 1, MPI_COMM_WORLD, &msg, &status);
+    }
+    else {
+        int flag;
+        MPI_Improbe(peer->first, 1, MPI_COMM_WORLD, &flag, &msg, &status);
+        if ( !flag ) return false;
+    }
+
+    // Nothing else is using the buffer, since the last exchange has
+    // been delivered
+    comm_pair& pair = peer->second;
+    int count;
+    MPI_Get_count(&status, MPI_BYTE, &count);
+    if ( static_cast<uint32_t>(count) > pair.local_size ) {
+        delete[] pair.rbuf;
+        pair.rbuf = new char[count];
+        pair.local_size = count;
+    }
+    MPI_Imrecv(pair.rbuf, count, MPI_BYTE, &msg, &rreqs[index]);
+    recv_started[index] = true;
+#endif
+    return true;
+}
+
+char*
+RankSyncSerialSkip::waitPipelinedRecv(comm_map_t::iterator UNUSED_WO_MPI(peer), size_t UNUSED_WO_MPI(index))
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    startPipelinedRecv(peer, index, true);
+    MPI_Wait(&rreqs[index], MPI_STATUS_IGNORE);
+    return peer->second.rbuf;
+#else
+    return nullptr;
+#endif
+}
+
+void
+RankSyncSerialSkip::poll()
+{
+    if ( in_flight ) exchangeDone();
+}
+
 void
 RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atomic<int>& UNUSED_WO_MPI(msg_count))
 {
@@ -245,11 +519,8 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
     if ( thread != 0 ) {
         return;
     }
-    // Maximum number of outstanding requests is 3 times the number of
-    // ranks I communicate with (1 recv, 2 sends per rank)
-    MPI_Request sreqs[2 * comm_map.size()];
-    MPI_Request rreqs[comm_map.size()];
-    int rreq_count = 0;
+    // One send per rank I communicate with
+    MPI_Request sreqs[comm_map.size()];
     int sreq_count = 0;
 
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
@@ -259,48 +530,20 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
         char* send_buffer = i->second.squeue->getData();
         // Cast to Header so we can get/fill in data
         SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
-        int tag = 1;
-        // Check to see if remote queue is big enough for data
-        if ( i->second.remote_size < hdr->buffer_size ) {
-            // not big enough, send message that will tell remote side to get larger buffer
-            hdr->mode = 1;
-            MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE, i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
-            tag = 2;
-        }
-        else {
-            hdr->mode = 0;
-        }
-        MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE, i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-
-        // Post all the receives
-        MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE, i->first, 1, MPI_COMM_WORLD, &rreqs[rreq_count++]);
+        MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE, i->first/*dest*/, 1, MPI_COMM_WORLD, &sreqs[sreq_count++]);
 
     }
 
-    // Wait for all recvs to complete
-    MPI_Waitall(rreq_count, rreqs, MPI_STATUSES_IGNORE);
-
-
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
 
-        // Get the buffer and deserialize all the events
+        // Receive the buffer, resized to fit the message if needed
+        recvSyncBuffer(i->first, 1, i->second.rbuf, i->second.local_size);
+
+        // Deserialize all the events
         char* buffer = i->second.rbuf;
 
         SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
         unsigned int size = hdr->buffer_size;
-        int mode = hdr->mode;
-
-        if ( mode == 1 ) {
-            // May need to resize the buffer
-            if ( size > i->second.local_size ) {
-                delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
-            }
-            MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE, i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            buffer = i->second.rbuf;
-        }
 
         SST::Core::Serialization::serializer ser;
         ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
@@ -15,8 +15,16 @@
 #include "sst/core/sst_types.h"
 #include "sst/core/syncManager.h"
 #include "sst/core/threadsafe.h"
+#include "sst/core/warnmacros.h"
 
 #include <map>
+#include <vector>
+
+#ifdef SST_CONFIG_HAVE_MPI
+DISABLE_WARN_MISSING_OVERRIDE
+#include <mpi.h>
+REENABLE_WARNING
+#endif
 
 namespace SST {
 
@@ -25,8 +33,18 @@ class TimeConverter;
 
 class RankSyncSerialSkip : public NewRankSync {
 public:
-    /** Create a new Sync object which fires with a specified period */
-    RankSyncSerialSkip(TimeConverter* minPartTC);
+    /** How events are exchanged at each sync */
+    enum Mode_t {
+        SKIP,       /*!< Blocking exchange over MPI */
+        PIPELINED,  /*!< Each exchange completes at the following sync, while the simulation runs */
+        SHARED      /*!< Ranks on the same node exchange through shared memory */
+    };
+
+    /** Create a new Sync object which fires with a specified period
+     * @param minPartTC Minimum latency between partitions
+     * @param mode How events are exchanged
+     */
+    RankSyncSerialSkip(TimeConverter* minPartTC, Mode_t mode = SKIP);
     virtual ~RankSyncSerialSkip();
 
     /** Register a Link which this Sync Object is responsible for */
@@ -41,9 +59,14 @@ public:
     void prepareForComplete() override;
 
     SimTime_t getNextSyncTime() override { return myNextSyncTime; }
+    void poll() override;
 
     uint64_t getDataSize() const override;
 
+    /** In pipelined mode the Exit state lags a sync behind, which
+     * is the same on every rank */
+    bool reducesExit() const override { return true; }
+
 private:
 
     static SimTime_t myNextSyncTime;
@@ -51,23 +74,84 @@ private:
     // Function that actually does the exchange during run
     void exchange();
 
+    /* Pipelined mode.  Events sent between two syncs are always at
+     * least a lookahead after the minimum time reduced at the first
+     * of them, so the exchange posted at one sync only has to finish
+     * by the sync after next.  Syncs are scheduled at that minimum
+     * plus the lookahead, which in steady state puts them half a
+     * lookahead apart. */
+    void exchangePipelined();
+    /** Start sending the events collected since the last sync and the
+     * reduction of the next activity time, and post the receives for
+     * the events coming back */
+    void postExchange();
+    /** Wait for the exchange started at the last sync and deliver the
+     * events received */
+    void completeExchange();
+    /** True if everything posted by postExchange() has finished.  Also
+     * starts the receives for buffers that have arrived. */
+    bool exchangeDone();
+
+    /* Shared mode.  Each rank has a window of shared memory with a slot
+     * for every peer on the same node.  Buffers that fit are copied
+     * into the slot and read by the peer in place after a node
+     * barrier; larger ones, and those for peers on other nodes, go
+     * over MPI.  The reduction that ends each exchange keeps a slot
+     * from being overwritten before it has been read. */
+    void setupSharedMemory();
+    void freeSharedMemory();
+
     struct comm_pair {
         SyncQueue* squeue; // SyncQueue
         char* rbuf; // receive buffer
         uint32_t local_size;
-        uint32_t remote_size;
+        char* shm_send; // my slot for this rank, nullptr if off node
+        char* shm_recv; // this rank's slot for me, nullptr if off node
+        // Links to this rank, indexed by the id carried in the events
+        std::vector<Link*> links;
     };
 
     typedef std::map<int, comm_pair > comm_map_t;
     typedef std::map<LinkId_t, Link*> link_map_t;
 
+    /** Match the pipelined buffer from a peer and start receiving it
+     * into rbuf, grown to fit.  Returns false if block is false and
+     * the buffer hasn't arrived yet. */
+    bool startPipelinedRecv(comm_map_t::iterator peer, size_t index, bool block);
+    /** Wait for the pipelined buffer from a peer.  Returns the buffer. */
+    char* waitPipelinedRecv(comm_map_t::iterator peer, size_t index);
+
     // TimeConverter* period;
     comm_map_t comm_map;
     link_map_t link_map;
+    std::vector<ActivityQueue*> link_queues;
 
     double mpiWaitTime;
     double deserializeTime;
 
+    bool pipelined;
+    bool shared;
+    /** True while an exchange started by postExchange() is in flight */
+    bool in_flight;
+    /** Time spent simulating while an exchange that was not finished
+     * when it was needed was in flight.  Set against mpiWaitTime, this
+     * shows how much of the exchange time was hidden. */
+    double mpiOverlapTime;
+    /** Exchanges posted, and those already finished when needed */
+    uint64_t exchanges;
+    uint64_t exchangesHidden;
+    /** Minimum next activity time reduced by the last completed exchange */
+    SimTime_t reduced_min;
+#ifdef SST_CONFIG_HAVE_MPI
+    std::vector<MPI_Request> sreqs;
+    std::vector<MPI_Request> rreqs;
+    /* Whether each of rreqs has been started */
+    std::vector<bool> recv_started;
+    Core::Profile::ProfData_t post_time;
+    MPI_Comm node_comm;
+    MPI_Win shm_win;
+#endif
+
 };
 
 } // namespace SST
@@ -24,10 +24,59 @@ class ser_packer :
   public ser_buffer_accessor
 {
  public:
+  ser_packer() :
+    grow_buffer_(nullptr),
+    grow_capacity_(nullptr),
+    grow_offset_(0)
+  {
+  }
+
+  void
+  init(void* buffer, size_t size){
+    grow_buffer_ = nullptr;
+    grow_capacity_ = nullptr;
+    ser_buffer_accessor::init(buffer, size);
+  }
+
+  /**
+   * @brief init_growable Pack into a buffer that is reallocated, at
+   * least doubling in size, when it runs out of space, so the data
+   * doesn't have to be sized first.  buffer and capacity are updated
+   * in place and the buffer stays owned by the caller.
+   * @param buffer  Buffer allocated with new[], may be nullptr
+   * @param capacity Size of buffer
+   * @param offset  Bytes reserved at the front of buffer
+   */
+  void
+  init_growable(char*& buffer, size_t& capacity, size_t offset){
+    grow_buffer_ = &buffer;
+    grow_capacity_ = &capacity;
+    grow_offset_ = offset;
+    if ( capacity < offset ) {
+      delete[] buffer;
+      buffer = new char[offset];
+      capacity = offset;
+    }
+    ser_buffer_accessor::init(buffer + offset, capacity - offset);
+  }
+
+  template <class T>
+  T*
+  next(){
+    if ( grow_buffer_ != nullptr && size_ + sizeof(T) > max_size_ ) grow(sizeof(T));
+    return ser_buffer_accessor::next<T>();
+  }
+
+  char*
+  next_str(size_t size){
+    if ( grow_buffer_ != nullptr && size_ + size > max_size_ ) grow(size);
+    return ser_buffer_accessor::next_str(size);
+  }
+
   template <class T>
   void
   pack(T& t){
-    T* buf = ser_buffer_accessor::next<T>();
+    T* buf = next<T>();
     *buf = t;
   }
 
@@ -42,6 +91,14 @@ class ser_packer :
   void
   pack_string(std::string& str);
 
+ private:
+  void
+  grow(size_t needed);
+
+  char** grow_buffer_;
+  size_t* grow_capacity_;
+  size_t grow_offset_;
+
 };
 
 } }
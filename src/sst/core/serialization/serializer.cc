@@ -14,6 +14,8 @@
 #include "sst/core/serialization/serializable.h"
 #include "sst/core/output.h"
 
+#include <algorithm>
+
 namespace SST {
 namespace Core {
 namespace Serialization {
@@ -46,6 +48,23 @@ ser_packer::pack_buffer(void* buf, int size)
   ::memcpy(charstr, buf, size);
 }
 
+void
+ser_packer::grow(size_t needed)
+{
+  size_t used = grow_offset_ + size_;
+  size_t capacity = std::max(2 * *grow_capacity_, used + needed);
+  char* buffer = new char[capacity];
+  if (*grow_buffer_ != nullptr){
+    ::memcpy(buffer, *grow_buffer_, used);
+    delete[] *grow_buffer_;
+  }
+  *grow_buffer_ = buffer;
+  *grow_capacity_ = capacity;
+  bufstart_ = buffer + grow_offset_;
+  bufptr_ = bufstart_ + size_;
+  max_size_ = capacity - grow_offset_;
+}
+
 void
 ser_unpacker::unpack_string(std::string& str)
 {
@@ -186,6 +186,14 @@ public:
         mode_ = PACK;
     }
 
+    /** Pack into buffer, reallocating it as needed so that the data
+     * doesn't have to be sized first.  See ser_packer::init_growable. */
+    void
+    start_packing_growable(char*& buffer, size_t& capacity, size_t offset = 0){
+        packer_.init_growable(buffer, capacity, offset);
+        mode_ = PACK;
+    }
+
     void
     start_sizing(){
         sizer_.reset();
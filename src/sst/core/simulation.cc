@@ -93,6 +93,7 @@ Simulation::~Simulation()
     //     }
     // }
 
+    if ( instance == this ) instance = nullptr;
 }
 
 Simulation*
@@ -103,6 +104,7 @@ Simulation::createSimulation(Config *config, RankInfo my_rank, RankInfo num_rank
 
     std::lock_guard<std::mutex> lock(simulationMutex);
     instanceMap[tid] = instance;
+    Simulation::instance = instance;
     instanceVec.resize(num_ranks.thread);
     instanceVec[my_rank.thread] = instance;
     return instance;
@@ -134,10 +136,14 @@ Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks, SimTi
 {
     sim_output.init(cfg->output_core_prefix, cfg->getVerboseLevel(), 0, Output::STDOUT);
     output_directory = "";
+    threadSyncType = cfg->threadSync;
+    rankSyncType = cfg->rankSync;
+    rebalancePeriod = cfg->rebalancePeriod.empty() ? 0 : timeLord.getSimCycles(cfg->rebalancePeriod, "rebalance period");
 
     Params p;
     //params get passed twice - both the params and a ctor argument
     timeVortex = factory->Create<TimeVortex>(cfg->timeVortex,p,p);
+    batchDelivery = timeVortex->supportsBatch();
     if( my_rank.thread == 0 ) {
         m_exit = new Exit( num_ranks.thread, timeLord.getTimeConverter("100ns"), min_part == MAX_SIMTIME_T );
     }
@@ -187,6 +193,8 @@ Simulation::requireEvent(const std::string& name)
 SimTime_t
 Simulation::getNextActivityTime() const
 {
+    // Activities left in the batch being executed come first
+    if ( !activityBatch.empty() ) return currentSimCycle;
     return timeVortex->front()->getDeliveryTime();
 }
 
@@ -323,6 +331,8 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
 
             lp.getLeft()->setLatency(clink.latency[0]);
             lp.getRight()->setLatency(clink.latency[1]);
+            lp.getLeft()->coalesce = clink.coalesce;
+            lp.getRight()->coalesce = clink.coalesce;
 
             // Add this link to the appropriate LinkMap
             ComponentInfo* cinfo = compInfoMap.getByID(clink.component[0]);
@@ -357,6 +367,7 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
             LinkPair lp(clink.id);
 
             lp.getLeft()->setLatency(clink.latency[local]);
+            lp.getLeft()->coalesce = clink.coalesce;
             lp.getRight()->setLatency(0);
             lp.getRight()->setDefaultTimeBase(minPartToTC(1));
 
@@ -535,12 +546,22 @@ void Simulation::run() {
     header += ", ";
     header += SST::to_string(my_rank.thread);
     header += ":  ";
+
+    // Events sent during setup
+    if ( !coalescedLinks.empty() ) flushCoalescedLinks();
+
     while( LIKELY( ! endSim ) ) {
-        currentSimCycle = timeVortex->front()->getDeliveryTime();
-        currentPriority = timeVortex->front()->getPriority();
-        current_activity = timeVortex->pop();
-        current_activity->execute();
+        if ( UNLIKELY( !coalescedLinks.empty() ) ) flushCoalescedLinksIfDue();
 
+        if ( LIKELY( !batchDelivery ) ) {
+            currentSimCycle = timeVortex->front()->getDeliveryTime();
+            currentPriority = timeVortex->front()->getPriority();
+            current_activity = timeVortex->pop();
+            current_activity->execute();
+        }
+        else {
+            executeBatch();
+        }
 
         if ( UNLIKELY( 0 != lastRecvdSignal ) ) {
             switch ( lastRecvdSignal ) {
@@ -562,11 +583,72 @@ void Simulation::run() {
             lastRecvdSignal = 0;
         }
     }
+
+    // Hand back anything left in the batch so the TimeVortex can
+    // delete it
+    std::vector<Activity*> remaining;
+    remaining.swap(activityBatch);
+    for ( auto* act : remaining ) {
+        timeVortex->insert(act);
+    }
+
     /* We shouldn't need to do this, but to be safe... */
     ThreadSync::disable();
+    syncManager->finishThread();
 
     runBarrier.wait();  // TODO<- Is this needed?
     if (num_ranks.rank != 1 && num_ranks.thread == 0) delete m_exit;
+
+#ifdef __SST_ENABLE_PROFILE__
+    // Report this thread's barrier waits in a single line so the
+    // output from different threads doesn't interleave
+    std::string hist;
+    uint64_t* waits = Core::ThreadSafe::Barrier::getWaitHistogram();
+    for ( int i = 0; i < Core::ThreadSafe::Barrier::WAIT_BUCKETS; i++ ) {
+        if ( waits[i] == 0 ) continue;
+        if ( i == Core::ThreadSafe::Barrier::WAIT_BUCKETS - 1 ) hist += " >=";
+        else hist += " <";
+        hist += std::to_string(1ull << (i == Core::ThreadSafe::Barrier::WAIT_BUCKETS - 1 ? i - 1 : i)) + "us: " + std::to_string(waits[i]);
+    }
+    sim_output.verbose(CALL_INFO, 1, 0, "Barrier waits for rank %u, thread %u:%s\n", my_rank.rank, my_rank.thread, hist.c_str());
+#endif
+}
+
+
+void Simulation::executeBatch()
+{
+    // All activities in a batch share the same time and priority.  A
+    // batch can be left part done to handle a signal.
+    if ( activityBatch.empty() ) {
+        timeVortex->popBatch(activityBatch);
+        currentSimCycle = activityBatch.back()->getDeliveryTime();
+        currentPriority = activityBatch.back()->getPriority();
+    }
+
+    while ( LIKELY( !activityBatch.empty() ) ) {
+        current_activity = activityBatch.back();
+        activityBatch.pop_back();
+        current_activity->execute();
+
+        // Signals are handled once the batch is done
+        if ( UNLIKELY( endSim || 0 != lastRecvdSignal ) ) break;
+    }
+}
+
+void Simulation::flushCoalescedLinksIfDue()
+{
+    // Events are held until the current time step is over, and the
+    // SyncManager has to see them before it runs
+    Activity* next = timeVortex->front();
+    if ( next->getDeliveryTime() != currentSimCycle || next == syncManager ) flushCoalescedLinks();
+}
+
+void Simulation::flushCoalescedLinks()
+{
+    for ( auto* link : coalescedLinks ) {
+        link->flushCoalesced();
+    }
+    coalescedLinks.clear();
 }
 
 
@@ -599,6 +681,8 @@ void Simulation::endSimulation(SimTime_t end)
     endSimCycle = end;
     endSim = true;
 
+    // Don't leave any threads waiting on this one for a sync
+    syncManager->finishThread();
     exitBarrier.wait();
 
 
@@ -860,6 +944,7 @@ SimTime_t Simulation::minPart;
 SharedRegionManager* Simulation::sharedRegionManager = new SharedRegionManagerImpl();
 std::unordered_map<std::thread::id, Simulation*> Simulation::instanceMap;
 std::vector<Simulation*> Simulation::instanceVec;
+thread_local Simulation* Simulation::instance = nullptr;
 std::atomic<int> Simulation::untimed_msg_count;
 Exit* Simulation::m_exit;
 
@@ -119,7 +119,11 @@ public:
     /********* Public Static API ************/
 
     /** Return a pointer to the singleton instance of the Simulation */
-    static Simulation *getSimulation() { return instanceMap.at(std::this_thread::get_id()); }
+    static Simulation *getSimulation() {
+        Simulation* sim = instance;
+        if ( LIKELY(sim != nullptr) ) return sim;
+        return instanceMap.at(std::this_thread::get_id());
+    }
 
     /**
      * Returns the Simulation's SharedRegionManager
@@ -502,6 +506,14 @@ private:
 
     TimeVortex* getTimeVortex() const { return timeVortex; }
 
+    /** Send on the events held back by coalescing Links */
+    void flushCoalescedLinks();
+    /** Flush the coalescing Links if the next activity is for a later
+     * time or is the SyncManager */
+    void flushCoalescedLinksIfDue();
+    /** Execute the activities of the next batch from timeVortex */
+    void executeBatch();
+
     /** Emergency Shutdown
      * Called when a SIGINT or SIGTERM has been seen
      */
@@ -518,11 +530,18 @@ private:
     } ShutdownMode_t;
 
     friend class SyncManager;
+    friend class NewRankSync;
+    friend class ThreadLoadBalancer;
 
     Mode_t   runMode;
     TimeVortex*      timeVortex;
     TimeConverter*   threadMinPartTC;
     Activity*        current_activity;
+    /** True if timeVortex delivers activities in batches */
+    bool             batchDelivery;
+    std::vector<Activity*> activityBatch;
+    /** Links holding back an event to coalesce with later ones */
+    std::vector<Link*> coalescedLinks;
     static SimTime_t minPart;
     static TimeConverter*   minPartTC;
     std::vector<SimTime_t> interThreadLatencies;
@@ -546,10 +565,16 @@ private:
     volatile sig_atomic_t lastRecvdSignal;
     ShutdownMode_t   shutdown_mode;
     std::string      output_directory;
+    std::string      threadSyncType;
+    std::string      rankSyncType;
+    SimTime_t        rebalancePeriod; // 0 if components never move between threads
     static SharedRegionManager* sharedRegionManager;
     bool             wireUpFinished;
 
     static std::unordered_map<std::thread::id, Simulation*> instanceMap;
+    /** Simulation owned by the calling thread.  Avoids looking up
+     * instanceMap in getSimulation(), which is on the send path. */
+    static thread_local Simulation* instance;
     static std::vector<Simulation*> instanceVec;
 
     friend void wait_my_turn_start();
@@ -14,15 +14,19 @@
 
 #include "sst/core/warnmacros.h"
 
+#include "sst/core/event.h"
 #include "sst/core/exit.h"
 #include "sst/core/simulation.h"
 #include "sst/core/syncBase.h"
+#include "sst/core/threadLoadBalancer.h"
 #include "sst/core/threadSyncQueue.h"
 #include "sst/core/timeConverter.h"
+#include "sst/core/timeVortex.h"
 
 #include "sst/core/rankSyncSerialSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
+#include "sst/core/threadSyncPairwiseSkip.h"
 #include "sst/core/threadSyncSimpleSkip.h"
 
 #ifdef SST_CONFIG_HAVE_MPI
@@ -41,6 +45,193 @@ NewRankSync* SyncManager::rankSync = nullptr;
 Core::ThreadSafe::Barrier SyncManager::RankExecBarrier[6];
 Core::ThreadSafe::Barrier SyncManager::LinkUntimedBarrier[3];
 SimTime_t SyncManager::next_rankSync = MAX_SIMTIME_T;
+ThreadLoadBalancer* SyncManager::loadBalancer = nullptr;
+
+void
+NewRankSync::deliverEvents(std::vector<Activity*>& events, const std::vector<Link*>& links, uint32_t from_rank)
+{
+    ActivityQueue* tv = Simulation::getSimulation()->getTimeVortex();
+
+    // Events for the TimeVortex are compacted to the front of events
+    size_t count = 0;
+    for ( auto* act : events ) {
+        Event* ev = static_cast<Event*>(act);
+        size_t index = ev->getLinkId();
+        if ( index >= links.size() ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link index %zu from rank %u out of range!\n", index, from_rank);
+        }
+
+        // The Link standing in for the sender carries any latency
+        // added on receive, as in NewThreadSync::deliverEvent()
+        Link* link = links[index];
+        Link* dest = link->pair_link;
+        ev->setDeliveryTime(ev->getDeliveryTime() + link->latency);
+        ev->setDeliveryLink(link->id, dest);
+#if __SST_DEBUG_EVENT_TRACKING__
+        ev->addSendComponent(link->comp, link->ctype, link->port);
+        ev->addRecvComponent(dest->comp, dest->ctype, dest->port);
+#endif
+        if ( dest->recvQueue == tv ) events[count++] = ev;
+        else dest->recvQueue->insert(ev);
+    }
+    events.resize(count);
+    tv->insertBatch(events);
+    events.clear();
+}
+
+#ifdef SST_CONFIG_HAVE_MPI
+namespace {
+
+/** Values combined across ranks at each rank sync */
+struct SyncReduction {
+    SimTime_t min_time;
+    uint64_t  exit_count;
+    SimTime_t end_time;
+};
+
+void reduceSyncState(void* invec, void* inoutvec, int* len, MPI_Datatype* UNUSED(type))
+{
+    SyncReduction* in = static_cast<SyncReduction*>(invec);
+    SyncReduction* inout = static_cast<SyncReduction*>(inoutvec);
+    for ( int i = 0; i < *len; i++ ) {
+        inout[i].min_time = std::min(inout[i].min_time, in[i].min_time);
+        inout[i].exit_count += in[i].exit_count;
+        inout[i].end_time = std::max(inout[i].end_time, in[i].end_time);
+    }
+}
+
+/** Type and operation used to reduce a SyncReduction.  Only used
+ * from one thread per rank. */
+void getSyncReductionOp(MPI_Datatype& type, MPI_Op& op)
+{
+    static MPI_Datatype sync_type = MPI_DATATYPE_NULL;
+    static MPI_Op sync_op;
+    if ( sync_type == MPI_DATATYPE_NULL ) {
+        MPI_Type_contiguous(3, MPI_UINT64_T, &sync_type);
+        MPI_Type_commit(&sync_type);
+        MPI_Op_create(&reduceSyncState, 1 /* commutative */, &sync_op);
+    }
+    type = sync_type;
+    op = sync_op;
+}
+
+SyncReduction getLocalSyncState(SimTime_t local_min)
+{
+    Exit* exit = Simulation::getSimulation()->getExit();
+    SyncReduction state;
+    state.min_time = local_min;
+    state.exit_count = ( exit->getRefCount() > 0 );
+    state.end_time = exit->getEndTime();
+    return state;
+}
+
+SimTime_t setGlobalSyncState(const SyncReduction& state)
+{
+    Simulation::getSimulation()->getExit()->setGlobalState(state.exit_count, state.end_time);
+    return state.min_time;
+}
+
+/* The reduction started by startReduceNextActivityAndExit() */
+SyncReduction pending_input;
+SyncReduction pending_output;
+MPI_Request pending_req = MPI_REQUEST_NULL;
+
+/** Receive a message matched by MPI_Mprobe or MPI_Improbe, first
+ * growing buffer if needed */
+void recvMatched(MPI_Message& msg, MPI_Status& status, char*& buffer, uint32_t& size)
+{
+    int count;
+    MPI_Get_count(&status, MPI_BYTE, &count);
+    if ( static_cast<uint32_t>(count) > size ) {
+        delete[] buffer;
+        buffer = new char[count];
+        size = count;
+    }
+    MPI_Mrecv(buffer, count, MPI_BYTE, &msg, MPI_STATUS_IGNORE);
+}
+
+}
+#endif
+
+void
+NewRankSync::recvSyncBuffer(int UNUSED_WO_MPI(rank), int UNUSED_WO_MPI(tag), char*& UNUSED_WO_MPI(buffer), uint32_t& UNUSED_WO_MPI(size))
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Message msg;
+    MPI_Status status;
+    MPI_Mprobe(rank, tag, MPI_COMM_WORLD, &msg, &status);
+    recvMatched(msg, status, buffer, size);
+#endif
+}
+
+bool
+NewRankSync::tryRecvSyncBuffer(int UNUSED_WO_MPI(rank), int UNUSED_WO_MPI(tag), char*& UNUSED_WO_MPI(buffer), uint32_t& UNUSED_WO_MPI(size))
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    int flag;
+    MPI_Message msg;
+    MPI_Status status;
+    MPI_Improbe(rank, tag, MPI_COMM_WORLD, &flag, &msg, &status);
+    if ( !flag ) return false;
+    recvMatched(msg, status, buffer, size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+SimTime_t
+NewRankSync::reduceNextActivityAndExit(SimTime_t UNUSED_WO_MPI(local_min))
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Datatype type;
+    MPI_Op op;
+    getSyncReductionOp(type, op);
+
+    SyncReduction input = getLocalSyncState(local_min);
+    SyncReduction output;
+    MPI_Allreduce( &input, &output, 1, type, op, MPI_COMM_WORLD );
+    return setGlobalSyncState(output);
+#else
+    return MAX_SIMTIME_T;
+#endif
+}
+
+void
+NewRankSync::startReduceNextActivityAndExit(SimTime_t UNUSED_WO_MPI(local_min))
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Datatype type;
+    MPI_Op op;
+    getSyncReductionOp(type, op);
+
+    pending_input = getLocalSyncState(local_min);
+    MPI_Iallreduce( &pending_input, &pending_output, 1, type, op, MPI_COMM_WORLD, &pending_req );
+#endif
+}
+
+bool
+NewRankSync::testReduceNextActivityAndExit()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    int flag;
+    MPI_Test(&pending_req, &flag, MPI_STATUS_IGNORE);
+    return flag;
+#else
+    return true;
+#endif
+}
+
+SimTime_t
+NewRankSync::finishReduceNextActivityAndExit()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Wait(&pending_req, MPI_STATUS_IGNORE);
+    return setGlobalSyncState(pending_output);
+#else
+    return MAX_SIMTIME_T;
+#endif
+}
 
 class EmptyRankSync : public NewRankSync {
 public:
@@ -82,6 +273,12 @@ public:
     uint64_t getDataSize() const override { return 0; }
 };
 
+bool
+NewThreadSync::checkExit(Exit* exit)
+{
+    return exit->getRefCount() == 0;
+}
+
 class EmptyThreadSync : public NewThreadSync {
 public:
     EmptyThreadSync () {
@@ -97,16 +294,17 @@ public:
     void prepareForComplete() override {}
 
     /** Register a Link which this Sync Object is responsible for */
-    void registerLink(LinkId_t UNUSED(link_id), Link* UNUSED(link)) override {}
+    void registerLink(int UNUSED(to_thread), LinkId_t UNUSED(link_id), Link* UNUSED(link)) override {}
     ActivityQueue* getQueueForThread(int UNUSED(tid)) override { return nullptr; }
 };
 
 
-SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeConverter* minPartTC, SimTime_t min_part, const std::vector<SimTime_t>& UNUSED(interThreadLatencies)) :
+SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeConverter* minPartTC, SimTime_t min_part, const std::vector<SimTime_t>& interThreadLatencies) :
     Action(),
     rank(rank),
     num_ranks(num_ranks),
     threadSync(nullptr),
+    threadSyncBarrier(true),
     min_part(min_part)
 {
     sim = Simulation::getSimulation();
@@ -117,9 +315,15 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeCo
         for ( auto &b : LinkUntimedBarrier ) { b.resize(num_ranks.thread); }
         if ( min_part != MAX_SIMTIME_T ) {
             if ( num_ranks.thread == 1 ) {
-                rankSync = new RankSyncSerialSkip(/*num_ranks,*/ minPartTC);
+                RankSyncSerialSkip::Mode_t mode = RankSyncSerialSkip::SKIP;
+                if ( sim->rankSyncType == "pipelined" ) mode = RankSyncSerialSkip::PIPELINED;
+                else if ( sim->rankSyncType == "shared" ) mode = RankSyncSerialSkip::SHARED;
+                rankSync = new RankSyncSerialSkip(/*num_ranks,*/ minPartTC, mode);
             }
             else {
+                if ( sim->rankSyncType != "skip" && rank.rank == 0 ) {
+                    sim->getSimulationOutput().output("WARNING: --rank-sync=%s requires one thread per rank.  Using --rank-sync=skip.\n", sim->rankSyncType.c_str());
+                }
                 rankSync = new RankSyncParallelSkip(num_ranks, minPartTC);
             }
         }
@@ -133,12 +337,31 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeCo
     // of the active threadsyncs.
     SimTime_t interthread_minlat = sim->getInterThreadMinLatency();
     if ( num_ranks.thread > 1 && interthread_minlat != MAX_SIMTIME_T ) {
-        threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        if ( sim->threadSyncType == "pairwise" ) {
+            threadSync = new ThreadSyncPairwiseSkip(num_ranks.thread, rank.thread, Simulation::getSimulation(), interThreadLatencies);
+            // Threads only wait on their neighbors, so they do not
+            // all meet at a thread sync
+            threadSyncBarrier = false;
+        }
+        else {
+            threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        }
     }
     else {
         threadSync = new EmptyThreadSync();
     }
 
+    // Components can only move between threads when all threads stop
+    // at every thread sync
+    if ( rank.thread == 0 && sim->rebalancePeriod != 0 ) {
+        if ( num_ranks.thread > 1 && interthread_minlat != MAX_SIMTIME_T && threadSyncBarrier ) {
+            loadBalancer = new ThreadLoadBalancer(num_ranks.thread, sim->rebalancePeriod, interthread_minlat);
+        }
+        else {
+            sim->getSimulationOutput().output("WARNING: --rebalance-period requires more than one thread, links between threads and --thread-sync=simple.  Components will not be moved between threads.\n");
+        }
+    }
+
     exit = sim->getExit();
 
     setPriority(SYNCPRIORITY);
@@ -161,7 +384,8 @@ SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, Li
         // side of the link
 
         // For the local ThreadSync, just need to register the link
-        threadSync->registerLink(link_id, link);
+        threadSync->registerLink(to_rank.thread, link_id, link);
+        threadLinks.emplace_back(to_rank.thread, link);
 
         // Need to get target queue from the remote ThreadSync
         NewThreadSync* remoteSync = Simulation::instanceVec[to_rank.thread]->syncManager->threadSync;
@@ -176,8 +400,21 @@ SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, Li
 void
 SyncManager::execute(void)
 {
+#ifdef USE_MEMPOOL
+    Activity::flushPoolMagazines();
+#endif
+
     switch ( next_sync_type ) {
     case RANK:
+        // Threads that are still working towards this sync may be
+        // waiting on our channels rather than at the barrier
+        threadSync->publishProgress(sim->getCurrentSimCycle());
+
+        if ( !threadSyncBarrier ) {
+            rankSyncPairwise();
+            break;
+        }
+
         // Need to make sure all threads have reached the sync to
         // guarantee that all events have been sent to the appropriate
         // queues.
@@ -200,11 +437,12 @@ SyncManager::execute(void)
         RankExecBarrier[2].wait();
 
         // Now call the threadSync after() call
+        threadSync->setNextRankSyncTime(rankSync->getNextSyncTime());
         threadSync->after();
 
         RankExecBarrier[3].wait();
 
-        if ( exit != nullptr && rank.thread == 0 ) exit->check();
+        if ( exit != nullptr && rank.thread == 0 && !rankSync->reducesExit() ) exit->check();
 
         RankExecBarrier[4].wait();
 
@@ -215,10 +453,11 @@ SyncManager::execute(void)
         break;
     case THREAD:
 
+        if ( rank.thread == 0 ) rankSync->poll();
         threadSync->execute();
 
         if ( /*num_ranks.rank == 1*/ min_part == MAX_SIMTIME_T ) {
-            if ( exit->getRefCount() == 0 ) {
+            if ( threadSync->checkExit(exit) ) {
                 endSimulation(exit->getEndTime());
             }
         }
@@ -227,8 +466,40 @@ SyncManager::execute(void)
     default:
         break;
     }
+    // Every event sent between threads has been delivered, so this is
+    // the place to move components
+    if ( loadBalancer != nullptr && !sim->endSim ) loadBalancer->execute(rank.thread, sim->getCurrentSimCycle());
     computeNextInsert();
-    RankExecBarrier[5].wait();
+    if ( threadSyncBarrier ) RankExecBarrier[5].wait();
+}
+
+/** Rank sync for thread syncs that don't meet at a barrier.  The
+ * thread sync doesn't need every thread stopped to compute its next
+ * sync time, so only the barriers around the rank exchange itself are
+ * kept. */
+void
+SyncManager::rankSyncPairwise()
+{
+    // All threads must have stopped, and so have sent everything,
+    // before events can be moved into the TimeVortices and the next
+    // rank sync time is computed from them
+    RankExecBarrier[0].wait();
+    threadSync->before();
+    RankExecBarrier[1].wait();
+
+    rankSync->execute(rank.thread);
+    // No thread runs again until after the next barrier, so the Exit
+    // counts can't change underneath the check
+    if ( exit != nullptr && rank.thread == 0 && !rankSync->reducesExit() ) exit->check();
+
+    RankExecBarrier[2].wait();
+
+    threadSync->setNextRankSyncTime(rankSync->getNextSyncTime());
+    threadSync->after();
+
+    if ( exit->getGlobalCount() == 0 ) {
+        endSimulation(exit->getEndTime());
+    }
 }
 
 /** Cause an exchange of Untimed Data to occur */
@@ -248,8 +519,19 @@ void
 SyncManager::finalizeLinkConfigurations()
 {
     threadSync->finalizeLinkConfigurations();
+
+    // For the run phase, cross-thread links can send straight to the
+    // remote ThreadSync.  All links have been registered by now.
+    for ( auto& tl : threadLinks ) {
+        NewThreadSync* remoteSync = Simulation::instanceVec[tl.first]->syncManager->threadSync;
+        ActivityQueue* queue = remoteSync->getDirectQueueForLink(tl.second->getId());
+        if ( queue != nullptr ) tl.second->recvQueue = queue;
+    }
+    threadLinks.clear();
+
     // Only thread 0 should call finalize on rankSync
     if ( rank.thread == 0 ) rankSync->finalizeLinkConfigurations();
+    threadSync->setNextRankSyncTime(rankSync->getNextSyncTime());
 
     // Need to figure out what sync comes first and insert object into
     // TimeVortex
@@ -265,6 +547,12 @@ SyncManager::prepareForComplete()
     if ( rank.thread == 0 ) rankSync->prepareForComplete();
 }
 
+void
+SyncManager::finishThread()
+{
+    threadSync->publishProgress(MAX_SIMTIME_T);
+}
+
 void
 SyncManager::computeNextInsert()
 {
@@ -15,10 +15,13 @@
 #include "sst/core/sst_types.h"
 
 #include "sst/core/action.h"
+#include "sst/core/activityQueue.h"
 #include "sst/core/link.h"
 #include "sst/core/rankInfo.h"
 #include "sst/core/threadsafe.h"
+#include "sst/core/warnmacros.h"
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 
@@ -27,6 +30,7 @@ namespace SST {
 class Exit;
 class Simulation;
 class SyncBase;
+class ThreadLoadBalancer;
 class ThreadSyncQueue;
 class TimeConverter;
 
@@ -44,12 +48,19 @@ public:
     virtual void prepareForComplete() = 0;
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
+    /** Called on thread 0 at thread syncs, so an exchange that
+     * continues between rank syncs can make progress */
+    virtual void poll() {}
 
     // void setMaxPeriod(TimeConverter* period) {max_period = period;}
     TimeConverter* getMaxPeriod() {return max_period;}
 
     virtual uint64_t getDataSize() const = 0;
 
+    /** True if execute() also reduces the Exit state across ranks, in
+     * which case Exit::check() doesn't need to be called after it */
+    virtual bool reducesExit() const { return false; }
+
 protected:
     SimTime_t nextSyncTime;
     TimeConverter* max_period;
@@ -66,6 +77,49 @@ protected:
         link->sendUntimedData_sync(data);
     }
 
+    /** Order the Links shared with one rank by id.  Both ranks see the
+     * same set of ids, so a Link's position in the sorted list can be
+     * used as its index on either side. */
+    void sortLinksById(std::vector<Link*>& links) {
+        std::sort(links.begin(), links.end(), [](Link* a, Link* b) { return a->id < b->id; });
+    }
+
+    /** Deliver events received from another rank during run.  Each
+     * event carries the index of its Link in links and already has
+     * its final delivery time.  Events are inserted directly into the
+     * receiving Link's queue, with those for the TimeVortex inserted
+     * as one batch.  The vector is cleared. */
+    void deliverEvents(std::vector<Activity*>& events, const std::vector<Link*>& links, uint32_t from_rank);
+
+    /** Reduce the next activity time across all ranks together with
+     * the Exit reference count and end time, in a single collective.
+     * The Exit state is passed on to Exit::setGlobalState().  Returns
+     * the global minimum of local_min. */
+    SimTime_t reduceNextActivityAndExit(SimTime_t local_min);
+    /** Start the same reduction as reduceNextActivityAndExit()
+     * without blocking.  Only one can be in flight per rank. */
+    void startReduceNextActivityAndExit(SimTime_t local_min);
+    /** Returns true if the reduction started by
+     * startReduceNextActivityAndExit() has finished */
+    bool testReduceNextActivityAndExit();
+    /** Wait for the reduction started by
+     * startReduceNextActivityAndExit() and pass the Exit state on.
+     * Returns the global minimum of local_min. */
+    SimTime_t finishReduceNextActivityAndExit();
+
+    /** Receive the sync buffer sent by rank with tag.  buffer is
+     * reallocated if it is smaller than the message, and size updated.
+     * Blocks until the message arrives. */
+    void recvSyncBuffer(int rank, int tag, char*& buffer, uint32_t& size);
+    /** Like recvSyncBuffer(), but returns false without receiving
+     * anything if the message hasn't arrived yet */
+    bool tryRecvSyncBuffer(int rank, int tag, char*& buffer, uint32_t& size);
+
+    /** Replace the queue a Link sends to during run */
+    void setRecvQueue(Link* link, ActivityQueue* queue) {
+        link->recvQueue = queue;
+    }
+
 private:
 
 };
@@ -84,12 +138,32 @@ public:
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
 
+    /** Called with the time of the next rank sync.  Events from other
+     * ranks are not delivered to this thread before then. */
+    virtual void setNextRankSyncTime(SimTime_t UNUSED(time)) {}
+    /** Tell the other threads that this thread will not execute
+     * anything before time.  MAX_SIMTIME_T means it has stopped. */
+    virtual void publishProgress(SimTime_t UNUSED(time)) {}
+
+    /** Called after execute() in single rank runs.  Returns true if
+     * every component is done and the simulation should end. */
+    virtual bool checkExit(Exit* exit);
+
     void setMaxPeriod(TimeConverter* period) {max_period = period;}
     TimeConverter* getMaxPeriod() {return max_period;}
 
-    /** Register a Link which this Sync Object is responsible for */
-    virtual void registerLink(LinkId_t link_id, Link* link) = 0;
+    /** Register a Link which this Sync Object is responsible for.
+     * to_thread is the thread on the other side of the Link. */
+    virtual void registerLink(int to_thread, LinkId_t link_id, Link* link) = 0;
     virtual ActivityQueue* getQueueForThread(int tid) = 0;
+    /** Returns a queue that other threads can use to send events
+     * directly to the Link registered as link_id during the run phase,
+     * or nullptr if events should go through getQueueForThread() */
+    virtual ActivityQueue* getDirectQueueForLink(LinkId_t UNUSED(link_id)) { return nullptr; }
+    /** Stop handling a Link that no longer crosses to another thread
+     * because a component moved.  Only called while every thread is
+     * stopped at a sync. */
+    virtual void unregisterLink(LinkId_t UNUSED(link_id)) {}
 
 protected:
     SimTime_t nextSyncTime;
@@ -107,6 +181,14 @@ protected:
         link->sendUntimedData_sync(data);
     }
 
+    /** Deliver an event that arrived from another thread.  link is
+     * the local stand-in for the sending side of the link. */
+    void deliverEvent(Link* link, Event* ev) {
+        ev->setDeliveryTime(ev->getDeliveryTime() + link->latency);
+        ev->setDeliveryLink(ev->getLinkId(), link->pair_link);
+        link->pair_link->recvQueue->insert(ev);
+    }
+
 private:
 };
 
@@ -124,12 +206,16 @@ public:
     /** Finish link configuration */
     void finalizeLinkConfigurations();
     void prepareForComplete();
+    /** Called when this thread stops executing events */
+    void finishThread();
 
     void print(const std::string& header, Output &out) const override;
 
     uint64_t getDataSize() const;
 
 private:
+    friend class ThreadLoadBalancer;
+
     enum sync_type_t { RANK, THREAD};
 
     RankInfo rank;
@@ -141,7 +227,12 @@ private:
 
     static NewRankSync*     rankSync;
     static SimTime_t        next_rankSync;
+    static ThreadLoadBalancer* loadBalancer;
     NewThreadSync*   threadSync;
+    /* false if threads do not all meet at a thread sync */
+    bool             threadSyncBarrier;
+    /* Cross-thread links, and the thread on the other end */
+    std::vector<std::pair<int, Link*>> threadLinks;
     Exit* exit;
     Simulation * sim;
 
@@ -149,6 +240,7 @@ private:
     SimTime_t min_part;
 
     void computeNextInsert();
+    void rankSyncPairwise();
 
 };
 
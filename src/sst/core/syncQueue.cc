@@ -24,7 +24,7 @@ using namespace Core::ThreadSafe;
 using namespace Core::Serialization;
 
 SyncQueue::SyncQueue() :
-    ActivityQueue(), buffer(nullptr), buf_size(0)
+    ActivityQueue(), buffer(nullptr), buf_size(0), data_min_time(MAX_SIMTIME_T)
 {
 }
 
@@ -53,6 +53,13 @@ SyncQueue::insert(Activity* activity)
     activities.push_back(activity);
 }
 
+void
+SyncQueue::insertBatch(const std::vector<Activity*>& batch)
+{
+    std::lock_guard<Spinlock> lock(slock);
+    activities.insert(activities.end(), batch.begin(), batch.end());
+}
+
 Activity*
 SyncQueue::pop()
 {
@@ -84,29 +91,19 @@ SyncQueue::getData()
 {
     std::lock_guard<Spinlock> lock(slock);
 
+    // The buffer is kept between calls and grown while packing, so
+    // the events are only walked once
     serializer ser;
-
-    ser.start_sizing();
+    ser.start_packing_growable(buffer, buf_size, sizeof(SyncQueue::Header));
 
     ser & activities;
 
     size_t size = ser.size();
 
-    if ( buf_size < ( size + sizeof(SyncQueue::Header) ) ) {
-        if ( buffer != nullptr ) {
-            delete[] buffer;
-        }
-
-        buf_size = size + sizeof(SyncQueue::Header);
-        buffer = new char[buf_size];
-    }
-
-    ser.start_packing(buffer + sizeof(SyncQueue::Header), size);
-
-    ser & activities;
-
     // Delete all the events
+    data_min_time = MAX_SIMTIME_T;
     for ( unsigned int i = 0; i < activities.size(); i++ ) {
+        if ( activities[i]->getDeliveryTime() < data_min_time ) data_min_time = activities[i]->getDeliveryTime();
         delete activities[i];
     }
     activities.clear();
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "sst/core/activityQueue.h"
+#include "sst/core/event.h"
 #include "sst/core/threadsafe.h"
 
 namespace SST {
@@ -30,7 +31,6 @@ class SyncQueue : public ActivityQueue {
 public:
 
     struct Header {
-        uint32_t mode;
         uint32_t count;
         uint32_t buffer_size;
     };
@@ -41,6 +41,7 @@ public:
     bool empty() override;
     int size() override;
     void insert(Activity* activity) override;
+    void insertBatch(const std::vector<Activity*>& batch) override;
     Activity* pop() override; // Not a good idea for this particular class
     Activity* front() override;
 
@@ -54,14 +55,77 @@ public:
         return buf_size + (activities.capacity() * sizeof(Activity*));
     }
 
+    /** Earliest delivery time of the activities serialized by the
+     * last call to getData(), or MAX_SIMTIME_T if there were none */
+    SimTime_t getDataMinTime() const { return data_min_time; }
+
 private:
     char* buffer;
     size_t buf_size;
+    SimTime_t data_min_time;
     std::vector<Activity*> activities;
 
     Core::ThreadSafe::Spinlock slock;
 };
 
+/**
+ * \class RankSyncLinkQueue
+ *
+ * Internal API
+ *
+ * Queue used during run by a Link whose other end is on another rank.
+ * Replaces the link id in each event with the index of the Link in the
+ * receiving rank's table before passing it to the SyncQueue, so the
+ * receiver can find the Link without a lookup.
+ */
+class RankSyncLinkQueue : public ActivityQueue {
+public:
+    RankSyncLinkQueue(SyncQueue* queue, LinkId_t index) :
+        ActivityQueue(),
+        queue(queue),
+        index(index)
+        {}
+    ~RankSyncLinkQueue() {}
+
+    bool empty() override {
+        return queue->empty();
+    }
+
+    int size() override {
+        return queue->size();
+    }
+
+    /** Tag the event with the link index and pass it to the SyncQueue */
+    void insert(Activity* activity) override {
+        Event* ev = static_cast<Event*>(activity);
+        ev->setDeliveryLink(index, nullptr);
+        queue->insert(ev);
+    }
+
+    /** Tag the events with the link index and pass them to the
+     * SyncQueue together */
+    void insertBatch(const std::vector<Activity*>& batch) override {
+        for ( auto* act : batch ) {
+            static_cast<Event*>(act)->setDeliveryLink(index, nullptr);
+        }
+        queue->insertBatch(batch);
+    }
+
+    /** Not supported */
+    Activity* pop() override {
+        return nullptr;
+    }
+
+    /** Not supported */
+    Activity* front() override {
+        return nullptr;
+    }
+
+private:
+    SyncQueue* queue;
+    LinkId_t index;
+};
+
 
 } //namespace SST
 
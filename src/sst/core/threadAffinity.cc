@@ -0,0 +1,299 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/threadAffinity.h"
+
+#include "sst/core/warnmacros.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef SST_CONFIG_HAVE_MPI
+DISABLE_WARN_MISSING_OVERRIDE
+#include <mpi.h>
+REENABLE_WARNING
+#endif
+
+
+using namespace SST::Core;
+
+namespace {
+
+struct CpuInfo {
+    int cpu;
+    int package;
+    int core;
+    /* First cpu sharing the last level cache */
+    int llc;
+};
+
+int readSysInt(const std::string& path, int def)
+{
+    std::ifstream in(path);
+    int val;
+    if ( !(in >> val) ) return def;
+    return val;
+}
+
+/* Cpus this process is allowed to run on */
+std::vector<int> getAvailableCpus()
+{
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if ( sched_getaffinity(0, sizeof(set), &set) == 0 ) {
+        for ( int i = 0; i < CPU_SETSIZE; i++ ) {
+            if ( CPU_ISSET(i, &set) ) cpus.push_back(i);
+        }
+    }
+#endif
+    if ( cpus.empty() ) {
+        int n = std::thread::hardware_concurrency();
+        for ( int i = 0; i < n; i++ ) cpus.push_back(i);
+    }
+    return cpus;
+}
+
+CpuInfo getCpuInfo(int cpu)
+{
+    CpuInfo info;
+    std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    info.cpu = cpu;
+    info.package = readSysInt(base + "/topology/physical_package_id", 0);
+    info.core = readSysInt(base + "/topology/core_id", cpu);
+
+    // The cache indices are ordered by level, so the last one that
+    // exists is the last level cache
+    info.llc = info.package;
+    for ( int i = 0; ; i++ ) {
+        std::ifstream in(base + "/cache/index" + std::to_string(i) + "/shared_cpu_list");
+        if ( !in ) break;
+        std::string list;
+        std::vector<int> shared;
+        if ( in >> list && parseCpuList(list, shared) && !shared.empty() ) {
+            info.llc = shared.front();
+        }
+    }
+    return info;
+}
+
+/*
+ * Order the threads so that the ones which communicate the most are
+ * next to each other: start with the busiest thread, then repeatedly
+ * append the unplaced thread with the most links to the last one
+ * placed.
+ */
+std::vector<uint32_t> orderByCommunication(uint32_t num_threads, const std::vector<std::vector<uint64_t>>& comm)
+{
+    std::vector<uint64_t> total(num_threads, 0);
+    for ( uint32_t i = 0; i < num_threads && i < comm.size(); i++ ) {
+        for ( uint32_t j = 0; j < num_threads && j < comm[i].size(); j++ ) {
+            if ( i != j ) total[i] += comm[i][j];
+        }
+    }
+
+    auto weight = [&](uint32_t i, uint32_t j) -> uint64_t {
+        if ( i >= comm.size() || j >= comm[i].size() ) return 0;
+        return comm[i][j];
+    };
+
+    std::vector<uint32_t> order;
+    std::vector<bool> placed(num_threads, false);
+    while ( order.size() < num_threads ) {
+        uint32_t best = num_threads;
+        for ( uint32_t i = 0; i < num_threads; i++ ) {
+            if ( placed[i] ) continue;
+            if ( best == num_threads ) {
+                best = i;
+                continue;
+            }
+            uint64_t w_i = order.empty() ? 0 : weight(order.back(), i);
+            uint64_t w_best = order.empty() ? 0 : weight(order.back(), best);
+            if ( w_i > w_best || (w_i == w_best && total[i] > total[best]) ) best = i;
+        }
+        placed[best] = true;
+        order.push_back(best);
+    }
+    return order;
+}
+
+// Larger than any CPU id we expect to see; also bounds the size of
+// an expanded range
+const unsigned long MAX_CPU_ID = 65535;
+
+bool parseCpuId(const std::string& str, int& cpu)
+{
+    char* end;
+    errno = 0;
+    unsigned long val = strtoul(str.c_str(), &end, 10);
+    if ( errno != 0 || *end != '\0' || val > MAX_CPU_ID ) return false;
+    cpu = static_cast<int>(val);
+    return true;
+}
+
+}
+
+
+bool SST::Core::parseCpuList(const std::string& list, std::vector<int>& cpus)
+{
+    cpus.clear();
+    size_t pos = 0;
+    while ( pos < list.size() ) {
+        size_t end = list.find(',', pos);
+        if ( end == std::string::npos ) end = list.size();
+        std::string item = list.substr(pos, end - pos);
+        pos = end + 1;
+
+        size_t dash = item.find('-');
+        std::string first = item.substr(0, dash);
+        std::string last = dash == std::string::npos ? first : item.substr(dash + 1);
+        if ( first.empty() || last.empty() ||
+             first.find_first_not_of("0123456789") != std::string::npos ||
+             last.find_first_not_of("0123456789") != std::string::npos ) {
+            return false;
+        }
+
+        int lo, hi;
+        if ( !parseCpuId(first, lo) || !parseCpuId(last, hi) || hi < lo ) return false;
+        for ( int i = lo; i <= hi; i++ ) cpus.push_back(i);
+    }
+    return !cpus.empty();
+}
+
+
+void SST::Core::getNodeLocalRank(uint32_t& local_rank, uint32_t& local_ranks)
+{
+    local_rank = 0;
+    local_ranks = 1;
+#ifdef SST_CONFIG_HAVE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if ( !initialized ) return;
+
+    MPI_Comm node_comm;
+    if ( MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm) != MPI_SUCCESS ) return;
+    int rank, size;
+    MPI_Comm_rank(node_comm, &rank);
+    MPI_Comm_size(node_comm, &size);
+    MPI_Comm_free(&node_comm);
+    local_rank = rank;
+    local_ranks = size;
+#endif
+}
+
+
+std::string SST::Core::computeThreadPlacement(const std::string& mode, uint32_t num_threads,
+                                              const std::vector<std::vector<uint64_t>>& comm,
+                                              uint32_t local_rank, uint32_t local_ranks,
+                                              std::vector<int>& cpus)
+{
+    cpus.clear();
+
+    if ( mode != "compact" && mode != "scatter" ) {
+        std::vector<int> list;
+        if ( !parseCpuList(mode, list) ) {
+            return "Invalid cpu list \"" + mode + "\" for thread affinity";
+        }
+        if ( list.size() < num_threads ) {
+            return "Thread affinity cpu list \"" + mode + "\" has fewer cpus than the " +
+                std::to_string(num_threads) + " threads requested";
+        }
+        // With more than one rank on the node, each rank takes its own
+        // block of the list if it is long enough
+        size_t offset = 0;
+        if ( list.size() >= (size_t)num_threads * local_ranks ) offset = (size_t)local_rank * num_threads;
+        for ( uint32_t i = 0; i < num_threads; i++ ) cpus.push_back(list[offset + i]);
+        return "";
+    }
+
+    std::vector<int> avail = getAvailableCpus();
+    std::vector<CpuInfo> info;
+    for ( int cpu : avail ) info.push_back(getCpuInfo(cpu));
+
+    if ( mode == "compact" ) {
+        // Fill a cache domain before moving to the next one
+        std::sort(info.begin(), info.end(), [](const CpuInfo& a, const CpuInfo& b) {
+                if ( a.package != b.package ) return a.package < b.package;
+                if ( a.llc != b.llc ) return a.llc < b.llc;
+                if ( a.core != b.core ) return a.core < b.core;
+                return a.cpu < b.cpu;
+            });
+    }
+    else {
+        // Round robin across packages, using one hardware thread of
+        // every core before doubling up
+        std::sort(info.begin(), info.end(), [](const CpuInfo& a, const CpuInfo& b) { return a.cpu < b.cpu; });
+        std::map<std::pair<int,int>, int> smt;
+        std::map<std::pair<int,int>, int> core_index;
+        std::map<int, int> cores_in_package;
+        std::vector<std::pair<std::pair<int,int>, size_t>> keys;
+        for ( size_t i = 0; i < info.size(); i++ ) {
+            auto core = std::make_pair(info[i].package, info[i].core);
+            if ( core_index.find(core) == core_index.end() ) core_index[core] = cores_in_package[info[i].package]++;
+            keys.push_back(std::make_pair(std::make_pair(smt[core]++, core_index[core]), i));
+        }
+        std::sort(keys.begin(), keys.end(), [&](const std::pair<std::pair<int,int>, size_t>& a,
+                                                const std::pair<std::pair<int,int>, size_t>& b) {
+                if ( a.first != b.first ) return a.first < b.first;
+                return info[a.second].package < info[b.second].package;
+            });
+        std::vector<CpuInfo> sorted;
+        for ( auto& k : keys ) sorted.push_back(info[k.second]);
+        info.swap(sorted);
+    }
+
+    if ( info.empty() ) return "Unable to determine the cpus available for thread affinity";
+
+    size_t offset = 0;
+    if ( info.size() >= (size_t)num_threads * local_ranks ) offset = (size_t)local_rank * num_threads;
+
+    std::vector<uint32_t> order;
+    if ( mode == "compact" ) {
+        order = orderByCommunication(num_threads, comm);
+    }
+    else {
+        for ( uint32_t i = 0; i < num_threads; i++ ) order.push_back(i);
+    }
+
+    // Oversubscribed threads wrap around
+    cpus.resize(num_threads);
+    for ( uint32_t k = 0; k < num_threads; k++ ) {
+        cpus[order[k]] = info[(offset + k) % info.size()].cpu;
+    }
+    return "";
+}
+
+
+bool SST::Core::bindThreadToCpu(int cpu)
+{
+#ifdef __linux__
+    if ( cpu < 0 || cpu >= CPU_SETSIZE ) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
@@ -0,0 +1,53 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_CORE_THREADAFFINITY
+#define _H_SST_CORE_THREADAFFINITY
+
+#include <inttypes.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Core {
+
+/** Parse a cpu list such as "0-3,8,10".  Returns false if it is malformed. */
+bool parseCpuList(const std::string& list, std::vector<int>& cpus);
+
+/** Find this process's position among the ranks on the same node */
+void getNodeLocalRank(uint32_t& local_rank, uint32_t& local_ranks);
+
+/**
+ * Choose a cpu for each of the num_threads threads of this rank.
+ *
+ * @param mode  compact, scatter or a cpu list
+ * @param comm  comm[i][j] is the number of links between threads i and j.
+ *              For compact, threads that share many links are placed
+ *              on neighboring cpus, which share caches.
+ * @param local_rank  position of this rank among the ranks on the node
+ * @param local_ranks  number of ranks on the node
+ * @param cpus  filled in with the cpu for each thread
+ * @return an error message, or an empty string on success
+ */
+std::string computeThreadPlacement(const std::string& mode, uint32_t num_threads,
+                                   const std::vector<std::vector<uint64_t>>& comm,
+                                   uint32_t local_rank, uint32_t local_ranks,
+                                   std::vector<int>& cpus);
+
+/** Pin the calling thread to cpu.  Returns false on failure. */
+bool bindThreadToCpu(int cpu);
+
+}
+}
+
+
+#endif
@@ -0,0 +1,318 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/threadLoadBalancer.h"
+
+#include "sst/core/componentInfo.h"
+#include "sst/core/exit.h"
+#include "sst/core/link.h"
+#include "sst/core/linkMap.h"
+#include "sst/core/simulation.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/timeConverter.h"
+#include "sst/core/timeVortex.h"
+
+#include <set>
+#include <unordered_map>
+
+namespace SST {
+
+bool ThreadLoadBalancer::tracking = false;
+Core::ThreadSafe::Barrier ThreadLoadBalancer::barrier[2];
+
+ThreadLoadBalancer::ThreadLoadBalancer(int num_threads, SimTime_t period, SimTime_t lookahead) :
+    num_threads(num_threads),
+    period(period),
+    lookahead(lookahead),
+    nextRebalance(period)
+{
+    barrier[0].resize(num_threads);
+    barrier[1].resize(num_threads);
+    tracking = true;
+}
+
+void
+ThreadLoadBalancer::execute(int thread, SimTime_t current)
+{
+    // All threads sync at the same times, so they all agree on
+    // whether to stop here
+    if ( current < nextRebalance ) return;
+
+    barrier[0].wait();
+    if ( thread == 0 ) {
+        rebalance(current);
+        nextRebalance = current + period;
+    }
+    barrier[1].wait();
+}
+
+void
+ThreadLoadBalancer::gather(ComponentInfo* info, Candidate& cand, SimTime_t current)
+{
+    cand.subtree.push_back(info);
+    // A pending OneShot is on this thread's OneShot list and would
+    // fire after the Component left
+    if ( info->oneShotEnd >= current ) cand.movable = false;
+
+    if ( info->link_map != nullptr ) {
+        for ( auto& l : info->link_map->getLinkMap() ) {
+            cand.links.push_back(l.second);
+        }
+    }
+    for ( auto& sub : info->subComponents ) {
+        gather(&sub.second, cand, current);
+    }
+}
+
+void
+ThreadLoadBalancer::rebalance(SimTime_t current)
+{
+    sims = Simulation::instanceVec;
+    comps.clear();
+
+    std::vector<uint64_t> thread_load(num_threads, 0);
+    uint64_t total = 0;
+    for ( int t = 0; t < num_threads; t++ ) {
+        for ( auto* info : sims[t]->compInfoMap ) {
+            Candidate cand;
+            cand.info = info;
+            cand.thread = t;
+            cand.target = t;
+            cand.load = info->load;
+            cand.movable = true;
+            info->load = 0;
+            gather(info, cand, current);
+
+            // SubComponents that share ports show up more than once
+            std::set<Link*> unique(cand.links.begin(), cand.links.end());
+            cand.links.assign(unique.begin(), unique.end());
+
+            thread_load[t] += cand.load;
+            total += cand.load;
+            comps.push_back(std::move(cand));
+        }
+    }
+    if ( total == 0 ) return;
+
+    // Find both ends of every Link.  Links with only one end on this
+    // rank go to another rank, and the rank sync can't follow a
+    // Component to another thread.
+    std::unordered_map<LinkId_t, std::vector<LinkEnd>> ends;
+    for ( size_t c = 0; c < comps.size(); c++ ) {
+        for ( auto* link : comps[c].links ) {
+            if ( link->pair_link == link ) continue;
+            ends[link->id].push_back({link, c});
+        }
+    }
+    std::vector<std::vector<std::pair<LinkEnd, LinkEnd>>> neighbors(comps.size());
+    for ( auto& e : ends ) {
+        if ( e.second.size() != 2 ) {
+            for ( auto& end : e.second ) comps[end.comp].movable = false;
+            continue;
+        }
+        neighbors[e.second[0].comp].push_back(std::make_pair(e.second[0], e.second[1]));
+        neighbors[e.second[1].comp].push_back(std::make_pair(e.second[1], e.second[0]));
+    }
+
+    // Repeatedly move the Component from the busiest thread to the
+    // least busy one that comes closest to splitting the difference
+    // between them.  A Component only moves once per rebalance.
+    double mean = (double)total / num_threads;
+    int moves = 0;
+    for ( int i = 0; i < num_threads; i++ ) {
+        int heavy = 0;
+        int light = 0;
+        for ( int t = 1; t < num_threads; t++ ) {
+            if ( thread_load[t] > thread_load[heavy] ) heavy = t;
+            if ( thread_load[t] < thread_load[light] ) light = t;
+        }
+        if ( thread_load[heavy] <= 1.1 * mean ) break;
+
+        uint64_t gap = thread_load[heavy] - thread_load[light];
+        size_t best = comps.size();
+        uint64_t best_dist = 0;
+        for ( size_t c = 0; c < comps.size(); c++ ) {
+            Candidate& cand = comps[c];
+            if ( !cand.movable || cand.target != heavy || cand.thread != heavy ) continue;
+            if ( cand.load == 0 || cand.load >= gap ) continue;
+
+            // Links that would cross threads need enough latency to
+            // stay within the thread sync's lookahead
+            bool fits = true;
+            for ( auto& n : neighbors[c] ) {
+                if ( comps[n.second.comp].target == light ) continue;
+                if ( n.first.link->latency < lookahead || n.second.link->latency < lookahead ) {
+                    fits = false;
+                    break;
+                }
+            }
+            if ( !fits ) continue;
+
+            uint64_t dist = cand.load > gap / 2 ? cand.load - gap / 2 : gap / 2 - cand.load;
+            if ( best == comps.size() || dist < best_dist ) {
+                best = c;
+                best_dist = dist;
+            }
+        }
+        if ( best == comps.size() ) break;
+
+        comps[best].target = light;
+        thread_load[heavy] -= comps[best].load;
+        thread_load[light] += comps[best].load;
+        moves++;
+    }
+    if ( moves == 0 ) return;
+
+    std::set<LinkId_t> rewire;
+    for ( size_t c = 0; c < comps.size(); c++ ) {
+        if ( comps[c].target == comps[c].thread ) continue;
+        Simulation::getSimulationOutput().verbose(CALL_INFO, 1, 0, "Moving component %s from thread %d to thread %d at time %" PRIu64 "\n",
+                                                  comps[c].info->getName().c_str(), comps[c].thread, comps[c].target, current);
+        moveComponent(comps[c]);
+        for ( auto& n : neighbors[c] ) rewire.insert(n.first.link->id);
+    }
+    for ( auto id : rewire ) {
+        rewireLink(id, ends[id]);
+    }
+    moveEvents(comps);
+}
+
+void
+ThreadLoadBalancer::moveComponent(Candidate& cand)
+{
+    Simulation* from = sims[cand.thread];
+    Simulation* to = sims[cand.target];
+
+    from->compInfoMap.erase(cand.info);
+    to->compInfoMap.insert(cand.info);
+    cand.info->setSimulation(to);
+
+    // Polling links keep their own queue
+    for ( auto* link : cand.links ) {
+        if ( link->recvQueue == from->timeVortex ) link->recvQueue = to->timeVortex;
+    }
+
+    for ( auto* info : cand.subtree ) {
+        from->getExit()->moveComponent(info->getID(), cand.thread, cand.target);
+
+        for ( auto& c : info->clocks ) {
+            auto key = std::make_pair(c.tc->getFactor(), c.priority);
+            auto old = from->clockMap.find(key);
+            bool empty;
+            bool registered = old != from->clockMap.end() && old->second->unregisterHandler(c.registered, empty);
+
+            // Even if the handler is not on the clock right now, the
+            // Component may reregister it later
+            Clock* clock;
+            auto dest = to->clockMap.find(key);
+            if ( dest == to->clockMap.end() ) {
+                clock = new Clock(c.tc, c.priority);
+                to->clockMap[key] = clock;
+            }
+            else {
+                clock = dest->second;
+            }
+            if ( !registered ) continue;
+
+            // Start an idle clock in step with the one the handler
+            // left so it sees the same cycle numbers
+            if ( !clock->scheduled ) {
+                clock->currentCycle = old->second->currentCycle;
+                clock->scheduled = true;
+                to->insertActivity(old->second->getDeliveryTime(), clock);
+            }
+            clock->registerHandler(c.registered);
+        }
+    }
+}
+
+void
+ThreadLoadBalancer::rewireLink(LinkId_t id, const std::vector<LinkEnd>& ends)
+{
+    Link* link[2] = { ends[0].link, ends[1].link };
+    int old_thread[2] = { comps[ends[0].comp].thread, comps[ends[1].comp].thread };
+    int new_thread[2] = { comps[ends[0].comp].target, comps[ends[1].comp].target };
+
+    // Latency added on receive is kept on the stand-in for the other
+    // side when the link crosses threads, and on the sending side
+    // when it doesn't
+    SimTime_t recv_latency[2] = { 0, 0 };
+    if ( old_thread[0] != old_thread[1] ) {
+        for ( int i = 0; i < 2; i++ ) {
+            Link* proxy = link[i]->pair_link;
+            recv_latency[i] = proxy->latency;
+            sims[old_thread[i]]->syncManager->threadSync->unregisterLink(id);
+            delete proxy;
+        }
+    }
+
+    if ( new_thread[0] == new_thread[1] ) {
+        link[0]->pair_link = link[1];
+        link[1]->pair_link = link[0];
+        link[0]->latency += recv_latency[1];
+        link[1]->latency += recv_latency[0];
+        return;
+    }
+
+    for ( int i = 0; i < 2; i++ ) {
+        Link* proxy = new Link(id);
+        proxy->pair_link = link[i];
+        link[i]->pair_link = proxy;
+        proxy->latency = recv_latency[i];
+        proxy->setDefaultTimeBase(sims[0]->minPartToTC(1));
+        proxy->sim = sims[new_thread[i]];
+        proxy->untimedQueue = Link::afterInitQueue;
+        sims[new_thread[i]]->syncManager->threadSync->registerLink(new_thread[1 - i], id, proxy);
+    }
+    for ( int i = 0; i < 2; i++ ) {
+        Link* proxy = link[i]->pair_link;
+        NewThreadSync* remote = sims[new_thread[1 - i]]->syncManager->threadSync;
+        proxy->recvQueue = remote->getDirectQueueForLink(id);
+        proxy->configuredQueue = remote->getQueueForThread(new_thread[i]);
+    }
+}
+
+void
+ThreadLoadBalancer::moveEvents(const std::vector<Candidate>& comps)
+{
+    std::unordered_map<Link*, int> moved;
+    std::set<int> sources;
+    for ( auto& cand : comps ) {
+        if ( cand.target == cand.thread ) continue;
+        sources.insert(cand.thread);
+        for ( auto* link : cand.links ) moved[link] = cand.target;
+    }
+
+    // Events are delivered through the TimeVortex of the thread that
+    // owns the receiving Link.  Everything else goes back in the order
+    // it came out.
+    for ( int t : sources ) {
+        TimeVortex* tv = sims[t]->timeVortex;
+        std::vector<Activity*> keep;
+        while ( !tv->empty() ) {
+            Activity* act = tv->pop();
+            Event* ev = dynamic_cast<Event*>(act);
+            if ( ev != nullptr ) {
+                // Events already moved here from another thread stay
+                auto dest = moved.find(ev->getDeliveryLink());
+                if ( dest != moved.end() && dest->second != t ) {
+                    sims[dest->second]->timeVortex->insert(ev);
+                    continue;
+                }
+            }
+            keep.push_back(act);
+        }
+        for ( auto* act : keep ) tv->insert(act);
+    }
+}
+
+} // namespace SST
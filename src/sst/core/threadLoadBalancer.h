@@ -0,0 +1,145 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADLOADBALANCER_H
+#define SST_CORE_THREADLOADBALANCER_H
+
+#include "sst/core/sst_types.h"
+
+#include "sst/core/clock.h"
+#include "sst/core/event.h"
+#include "sst/core/threadsafe.h"
+
+#include <chrono>
+#include <vector>
+
+namespace SST {
+
+class ComponentInfo;
+class Link;
+class Simulation;
+
+/**
+ * Moves Components between the threads of a rank so that the time
+ * spent in their handlers is spread evenly.
+ *
+ * While it is enabled, the clock and event handlers registered by
+ * (Sub)Components are wrapped so that the time spent in them is
+ * charged to the Component.  Every period, all threads stop at a
+ * thread sync and thread 0 moves Components from the busiest threads
+ * to the least busy ones, rewiring their Links and moving their
+ * clocks and pending events along with them.
+ *
+ * Only used with ThreadSyncSimpleSkip, where all threads meet at
+ * every sync.
+ */
+class ThreadLoadBalancer {
+public:
+    /** Clock handler that charges the time spent in handler to a Component */
+    class TimedClockHandler : public Clock::HandlerBase {
+    public:
+        TimedClockHandler(Clock::HandlerBase* handler, uint64_t* load) :
+            handler(handler),
+            load(load)
+        {}
+        ~TimedClockHandler() { delete handler; }
+
+        bool operator()(Cycle_t cycle) override {
+            uint64_t start = now();
+            bool ret = (*handler)(cycle);
+            *load += now() - start;
+            return ret;
+        }
+
+    private:
+        Clock::HandlerBase* handler;
+        uint64_t* load;
+    };
+
+    /** Event handler that charges the time spent in handler to a Component */
+    class TimedEventHandler : public Event::HandlerBase {
+    public:
+        TimedEventHandler(Event::HandlerBase* handler, uint64_t* load) :
+            handler(handler),
+            load(load)
+        {}
+        ~TimedEventHandler() { delete handler; }
+
+        void operator()(Event* ev) override {
+            uint64_t start = now();
+            (*handler)(ev);
+            *load += now() - start;
+        }
+
+    private:
+        Event::HandlerBase* handler;
+        uint64_t* load;
+    };
+
+    /**
+     * @param num_threads Number of threads in the rank
+     * @param period Simulated time between rebalances
+     * @param lookahead Lookahead of the thread sync.  Links that end
+     *        up crossing threads must have at least this latency.
+     */
+    ThreadLoadBalancer(int num_threads, SimTime_t period, SimTime_t lookahead);
+    ~ThreadLoadBalancer() {}
+
+    /** Called by every thread at each thread sync, after the events
+     * sent between threads have been delivered */
+    void execute(int thread, SimTime_t current);
+
+    /** True if handlers should be wrapped to measure their load */
+    static bool isTracking() { return tracking; }
+
+private:
+    /** A Component and everything that moves with it */
+    struct Candidate {
+        ComponentInfo* info;
+        int thread;
+        int target;
+        uint64_t load;
+        bool movable;
+        std::vector<Link*> links;
+        std::vector<ComponentInfo*> subtree;
+    };
+
+    /** One end of a Link */
+    struct LinkEnd {
+        Link* link;
+        size_t comp;
+    };
+
+    void rebalance(SimTime_t current);
+    void gather(ComponentInfo* info, Candidate& cand, SimTime_t current);
+    void moveComponent(Candidate& cand);
+    void rewireLink(LinkId_t id, const std::vector<LinkEnd>& ends);
+    void moveEvents(const std::vector<Candidate>& comps);
+
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int num_threads;
+    SimTime_t period;
+    SimTime_t lookahead;
+    SimTime_t nextRebalance;
+    std::vector<Simulation*> sims;
+    std::vector<Candidate> comps;
+
+    static bool tracking;
+    static Core::ThreadSafe::Barrier barrier[2];
+};
+
+} // namespace SST
+
+#endif // SST_CORE_THREADLOADBALANCER_H
@@ -0,0 +1,345 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/threadSyncPairwiseSkip.h"
+
+#include "sst/core/event.h"
+#include "sst/core/exit.h"
+#include "sst/core/link.h"
+#include "sst/core/profile.h"
+#include "sst/core/simulation.h"
+#include "sst/core/timeConverter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace SST {
+
+ThreadSyncPairwiseSkip::Channel* ThreadSyncPairwiseSkip::channels = nullptr;
+ThreadSyncPairwiseSkip::ThreadState* ThreadSyncPairwiseSkip::states = nullptr;
+std::atomic<int> ThreadSyncPairwiseSkip::exitWaiters(0);
+
+static inline SimTime_t
+addLookahead(SimTime_t time, SimTime_t lookahead)
+{
+    return time >= MAX_SIMTIME_T - lookahead ? MAX_SIMTIME_T : time + lookahead;
+}
+
+/* Replaces array, which is freed, with count cache aligned objects */
+template<typename T>
+static void
+allocateAligned(Simulation* sim, T*& array, int count)
+{
+    free(array);
+    void* mem;
+    if ( posix_memalign(&mem, alignof(T), count * sizeof(T)) != 0 ) {
+        sim->getSimulationOutput().fatal(CALL_INFO, 1, "Unable to allocate the thread sync state\n");
+    }
+    array = static_cast<T*>(mem);
+    for ( int i = 0; i < count; i++ ) {
+        new (&array[i]) T();
+    }
+}
+
+/** Create a new ThreadSyncPairwiseSkip object */
+ThreadSyncPairwiseSkip::ThreadSyncPairwiseSkip(int num_threads, int thread, Simulation* sim, const std::vector<SimTime_t>& interThreadLatencies) :
+    NewThreadSync(),
+    nextRankSyncTime(MAX_SIMTIME_T),
+    published(0),
+    ending(false),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    totalWaitTime(0.0)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new ThreadSyncQueue());
+        staging.push_back(new ThreadSyncDirectQueue::staging_t());
+    }
+
+    if ( thread == 0 ) {
+        allocateAligned(sim, channels, num_threads * num_threads);
+        allocateAligned(sim, states, num_threads);
+    }
+
+    // Links are bidirectional, so the threads we receive from are
+    // the same as the ones we send to.
+    my_max_period = MAX_SIMTIME_T;
+    for ( int i = 0; i < num_threads; i++ ) {
+        if ( i == thread || interThreadLatencies[i] == MAX_SIMTIME_T ) continue;
+        neighbors.push_back({i, interThreadLatencies[i]});
+        if ( interThreadLatencies[i] < my_max_period ) my_max_period = interThreadLatencies[i];
+    }
+
+    // A thread with no links to other threads never has to wait, but
+    // still needs to sync periodically to notice the end of the
+    // simulation.
+    if ( neighbors.empty() ) my_max_period = sim->getInterThreadMinLatency();
+
+    // Only single rank runs check the Exit at thread syncs
+    exitCheckPeriod = MAX_SIMTIME_T;
+    if ( sim->getNumRanks().rank == 1 ) exitCheckPeriod = sim->getInterThreadMinLatency();
+    exit = sim->getExit();
+    nextExitCheck = exitCheckPeriod;
+    nextSyncTime = my_max_period < nextExitCheck ? my_max_period : nextExitCheck;
+}
+
+ThreadSyncPairwiseSkip::~ThreadSyncPairwiseSkip()
+{
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncPairwiseSkip total wait time: %lg seconds.\n", totalWaitTime);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+        delete staging[i];
+    }
+    queues.clear();
+    staging.clear();
+    for ( auto& dq : direct_queues ) {
+        delete dq.second;
+    }
+    direct_queues.clear();
+}
+
+void
+ThreadSyncPairwiseSkip::registerLink(int to_thread, LinkId_t link_id, Link* link)
+{
+    link_map[link_id] = link;
+    direct_queues[link_id] = new ThreadSyncDirectQueue(link, staging[to_thread]);
+}
+
+ActivityQueue*
+ThreadSyncPairwiseSkip::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+ActivityQueue*
+ThreadSyncPairwiseSkip::getDirectQueueForLink(LinkId_t link_id)
+{
+    auto dq = direct_queues.find(link_id);
+    if ( dq == direct_queues.end() ) return nullptr;
+    return dq->second;
+}
+
+SimTime_t
+ThreadSyncPairwiseSkip::getSafeTime()
+{
+    // A neighbor updates the channel after pushing the events it has
+    // sent, so once the channel is read every event it sent before
+    // then is in the staging area.
+    SimTime_t safe = MAX_SIMTIME_T;
+    for ( auto& n : neighbors ) {
+        SimTime_t t = getChannel(n.thread, thread).safe.load(std::memory_order_acquire);
+        if ( t < safe ) safe = t;
+    }
+    return safe;
+}
+
+void
+ThreadSyncPairwiseSkip::drainStaging()
+{
+    // In thread order, as in ThreadSyncSimpleSkip
+    Event* ev;
+    for ( auto* from : staging ) {
+        while ( from->try_remove(ev) ) {
+            deliverEvent(ev->getDeliveryLink(), ev);
+        }
+    }
+}
+
+void
+ThreadSyncPairwiseSkip::publishProgress(SimTime_t time)
+{
+    if ( time <= published ) return;
+    published = time;
+    for ( auto& n : neighbors ) {
+        getChannel(thread, n.thread).safe.store(addLookahead(time, n.lookahead), std::memory_order_release);
+    }
+    states[thread].progress.store(time, std::memory_order_release);
+
+    for ( auto& n : neighbors ) {
+        states[n.thread].wakeup.notify();
+    }
+    notifyExitWaiters();
+}
+
+void
+ThreadSyncPairwiseSkip::notifyExitWaiters()
+{
+    // Ordered against the increment in execute() in the same way as
+    // Waiter::notify()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ( exitWaiters.load(std::memory_order_relaxed) == 0 ) return;
+    for ( int i = 0; i < num_threads; i++ ) {
+        if ( i != thread ) states[i].wakeup.notify();
+    }
+}
+
+void
+ThreadSyncPairwiseSkip::publishDone()
+{
+    // Called at every sync before any progress is published, so a
+    // thread that has published progress past some time without being
+    // done was still running at that time
+    if ( exitCheckPeriod == MAX_SIMTIME_T ) return;
+    SimTime_t done = exit->getThreadEndTime(thread);
+    if ( done != states[thread].done.load(std::memory_order_relaxed) ) {
+        states[thread].done.store(done, std::memory_order_release);
+        notifyExitWaiters();
+    }
+}
+
+bool
+ThreadSyncPairwiseSkip::decideExit(SimTime_t current)
+{
+    // The simulation ends at the first exit check after every thread
+    // is done, which is the same check for all of them.  It doesn't
+    // end here if any thread is still running at this time.
+    if ( states[thread].done.load(std::memory_order_relaxed) == MAX_SIMTIME_T ) return true;
+    bool known = true;
+    for ( int i = 0; i < num_threads; i++ ) {
+        // Progress is read first, since it is published after done
+        SimTime_t progress = states[i].progress.load(std::memory_order_acquire);
+        SimTime_t done = states[i].done.load(std::memory_order_acquire);
+        if ( done == MAX_SIMTIME_T ) {
+            if ( progress >= current ) return true;
+            // Not known until the thread gets here
+            known = false;
+        }
+        else if ( done >= current ) return true;
+    }
+    ending = known;
+    return known;
+}
+
+void
+ThreadSyncPairwiseSkip::advance(SimTime_t safe)
+{
+    // Nothing will be executed on this thread before the earliest of
+    // its own next activity, the next event that can arrive from a
+    // neighbor and the next rank sync.
+    SimTime_t bound = sim->getNextActivityTime();
+    if ( safe < bound ) bound = safe;
+    if ( nextRankSyncTime < bound ) bound = nextRankSyncTime;
+    publishProgress(bound);
+
+    // Sync again once the neighbors could have caught up with what
+    // we just published, or when we run out of safe time.
+    SimTime_t next = addLookahead(bound, my_max_period);
+    nextSyncTime = safe < next ? safe : next;
+    if ( nextExitCheck < nextSyncTime ) nextSyncTime = nextExitCheck;
+}
+
+void
+ThreadSyncPairwiseSkip::before()
+{
+    drainStaging();
+}
+
+void
+ThreadSyncPairwiseSkip::after()
+{
+    // Called after a rank sync, which this thread could not have
+    // reached without being safe up to the current time, so there is
+    // no need to wait for the neighbors
+    publishDone();
+    SimTime_t safe = getSafeTime();
+    drainStaging();
+    advance(safe);
+}
+
+void
+ThreadSyncPairwiseSkip::execute()
+{
+    auto startTime = SST::Core::Profile::now();
+    SimTime_t current = sim->getCurrentSimCycle();
+
+    bool atExitCheck = current == nextExitCheck;
+    if ( atExitCheck ) nextExitCheck = addLookahead(nextExitCheck, exitCheckPeriod);
+    publishDone();
+
+    // Wait until every inbound channel is safe past the current time,
+    // and at an exit check until it is known whether to end.  Only a
+    // thread that is done itself can have to wait for that, and it
+    // depends on every other thread, not just the neighbors.
+    bool waitExit = atExitCheck && states[thread].done.load(std::memory_order_relaxed) != MAX_SIMTIME_T;
+    SimTime_t safe = getSafeTime();
+    drainStaging();
+    if ( safe <= current || ( waitExit && !decideExit(current) ) ) {
+        if ( waitExit ) exitWaiters.fetch_add(1);
+        // Keep publishing our own progress while waiting, since other
+        // threads may be waiting on us as well
+        states[thread].wakeup.waitUntil([&]() {
+            advance(safe);
+            safe = getSafeTime();
+            drainStaging();
+            return safe > current && ( !waitExit || decideExit(current) );
+        });
+        if ( waitExit ) exitWaiters.fetch_sub(1);
+    }
+    advance(safe);
+    totalWaitTime += SST::Core::Profile::getElapsed(startTime);
+}
+
+bool
+ThreadSyncPairwiseSkip::checkExit(Exit* UNUSED(exit))
+{
+    return ending;
+}
+
+void
+ThreadSyncPairwiseSkip::processLinkUntimedData()
+{
+    // Need to walk through all the queues and send the data to the
+    // correct links
+    for ( int i = 0; i < num_threads; i++ ) {
+        ThreadSyncQueue* queue = queues[i];
+        std::vector<Activity*>& vec = queue->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            Event* ev = static_cast<Event*>(vec[j]);
+            auto link = link_map.find(ev->getLinkId());
+            if (link == link_map.end()) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            } else {
+                sendUntimedData_sync(link->second,ev);
+            }
+        }
+        queue->clear();
+    }
+}
+
+void
+ThreadSyncPairwiseSkip::finalizeLinkConfigurations() {
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        finalizeConfiguration(i->second);
+    }
+
+    // Nothing has run yet, so the lookahead alone is safe
+    for ( auto& n : neighbors ) {
+        getChannel(thread, n.thread).safe.store(n.lookahead, std::memory_order_release);
+    }
+}
+
+void
+ThreadSyncPairwiseSkip::prepareForComplete() {
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        prepareForCompleteInt(i->second);
+    }
+}
+
+uint64_t
+ThreadSyncPairwiseSkip::getDataSize() const {
+    size_t count = 0;
+    return count;
+}
+
+} // namespace SST
@@ -0,0 +1,151 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCPAIRWISESKIP_H
+#define SST_CORE_THREADSYNCPAIRWISESKIP_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <unordered_map>
+
+#include "sst/core/action.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/threadsafe.h"
+#include "sst/core/threadSyncQueue.h"
+
+namespace SST {
+
+class ActivityQueue;
+class Link;
+class TimeConverter;
+class Exit;
+class Event;
+class Simulation;
+class ThreadSyncQueue;
+
+/**
+ * Conservative thread synchronization using channel clocks
+ * (Chandy-Misra-Bryant).  Each direction of each pair of threads that
+ * are linked is a channel.  The sending thread publishes a monotonic
+ * "safe until" time on the channel: a promise that nothing it sends
+ * in the future will arrive before then.  A thread only waits on its
+ * own inbound channels, so loosely coupled threads are free to run
+ * ahead of each other.  There are no global barriers outside of rank
+ * syncs.  In single rank runs each thread also publishes the time its
+ * primary components were done, and every thread ends at the first
+ * exit check after the last of them.
+ */
+class ThreadSyncPairwiseSkip : public NewThreadSync {
+public:
+    /** Create a new ThreadSync object */
+    ThreadSyncPairwiseSkip(int num_threads, int thread, Simulation* sim, const std::vector<SimTime_t>& interThreadLatencies);
+    ~ThreadSyncPairwiseSkip();
+
+    void before() override;
+    void after() override;
+    void execute(void) override;
+
+    /** Cause an exchange of Untimed Data to occur */
+    void processLinkUntimedData() override;
+    /** Finish link configuration */
+    void finalizeLinkConfigurations() override;
+    void prepareForComplete() override;
+
+    void setNextRankSyncTime(SimTime_t time) override { nextRankSyncTime = time; }
+    void publishProgress(SimTime_t time) override;
+    bool checkExit(Exit* exit) override;
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(int to_thread, LinkId_t link_id, Link* link) override;
+    ActivityQueue* getQueueForThread(int tid) override;
+    ActivityQueue* getDirectQueueForLink(LinkId_t link_id) override;
+
+    uint64_t getDataSize() const;
+
+private:
+    struct Neighbor {
+        int thread;
+        /* Minimum latency of the links to this thread */
+        SimTime_t lookahead;
+    };
+
+    /* Written only by the sending thread, read only by the
+     * receiving thread */
+    struct CACHE_ALIGNED_T Channel {
+        std::atomic<SimTime_t> safe;
+
+        Channel() : safe(0) {}
+    };
+
+    /* Written only by the owning thread, apart from wakeup */
+    struct CACHE_ALIGNED_T ThreadState {
+        /* Time before which the thread will not execute anything */
+        std::atomic<SimTime_t> progress;
+        /* Time the thread's primary components were done, or
+         * MAX_SIMTIME_T while they are not */
+        std::atomic<SimTime_t> done;
+        /* Notified by the neighbors when they publish progress, and by
+         * every thread while this one waits at an exit check */
+        Core::ThreadSafe::Waiter wakeup;
+
+        ThreadState() : progress(0), done(MAX_SIMTIME_T) {}
+    };
+
+    std::vector<ThreadSyncQueue*> queues;
+    std::unordered_map<LinkId_t, Link*> link_map;
+    /* Events sent to this thread during the run phase, with a staging
+     * area for each sending thread so they can be drained in thread
+     * order */
+    std::vector<ThreadSyncDirectQueue::staging_t*> staging;
+    std::unordered_map<LinkId_t, ThreadSyncDirectQueue*> direct_queues;
+    std::vector<Neighbor> neighbors;
+    SimTime_t my_max_period;
+    SimTime_t nextRankSyncTime;
+    SimTime_t published;
+    /* Every thread syncs at multiples of exitCheckPeriod, so that all
+     * of them can end at the same one */
+    SimTime_t exitCheckPeriod;
+    SimTime_t nextExitCheck;
+    bool ending;
+    Exit* exit;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    /* Channel from thread i to thread j is at j * num_threads + i.
+     * Allocated with posix_memalign, since new and std::vector only
+     * honour the alignment of Channel from C++17. */
+    static Channel* channels;
+    /* Indexed by thread, allocated in the same way */
+    static ThreadState* states;
+    /* Number of threads waiting at an exit check */
+    static std::atomic<int> exitWaiters;
+    double totalWaitTime;
+
+    Channel& getChannel(int from, int to) { return channels[to * num_threads + from]; }
+    /** Time before which all events from neighbors have been sent */
+    SimTime_t getSafeTime();
+    /** Publish new channel times and compute the next sync */
+    void advance(SimTime_t safe);
+    void drainStaging();
+    /** Publish the time this thread's primary components were done */
+    void publishDone();
+    /** Wake the threads waiting at an exit check, if any */
+    void notifyExitWaiters();
+    /** At an exit check, returns true once it is known whether the
+     * simulation ends there, and sets ending if it does */
+    bool decideExit(SimTime_t current);
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCPAIRWISESKIP_H
@@ -14,6 +14,8 @@
 #define SST_CORE_THREADSYNCQUEUE_H
 
 #include "sst/core/activityQueue.h"
+#include "sst/core/event.h"
+#include "sst/core/threadsafe.h"
 
 namespace SST {
 
@@ -66,6 +68,71 @@ private:
 
 };
 
+/** Queue used to send events directly to a thread during the run
+ * phase.  Each cross-thread link gets its own queue, which tags the
+ * event with the receiving thread's end of the link and pushes it into
+ * the lock-free staging area the receiving thread keeps for the
+ * sending thread.  The staging areas are drained by the receiving
+ * thread at the next sync.
+ */
+class ThreadSyncDirectQueue : public ActivityQueue {
+public:
+    typedef Core::ThreadSafe::MPSCQueue<Event*> staging_t;
+
+    ThreadSyncDirectQueue(Link* link, staging_t* staging) :
+        ActivityQueue(),
+        link(link),
+        staging(staging)
+        {}
+    ~ThreadSyncDirectQueue() {}
+
+    /** Returns true if the staging area is empty */
+    bool empty() override {
+        return staging->empty();
+    }
+
+    /** Not supported */
+    int size() override {
+        return 0;
+    }
+
+    /** Not supported */
+    Activity* pop() override {
+        return nullptr;
+    }
+
+    /** Insert a new activity into the staging area */
+    void insert(Activity* activity) override {
+        Event* ev = static_cast<Event*>(activity);
+        ev->setDeliveryLink(ev->getLinkId(), link);
+        staging->insert(ev, nodes);
+    }
+
+    /** Insert all the activities into the staging area at once */
+    void insertBatch(const std::vector<Activity*>& batch) override {
+        events.clear();
+        for ( auto* act : batch ) {
+            Event* ev = static_cast<Event*>(act);
+            ev->setDeliveryLink(ev->getLinkId(), link);
+            events.push_back(ev);
+        }
+        staging->insert(events, nodes);
+    }
+
+    /** Not supported */
+    Activity* front() override {
+        return nullptr;
+    }
+
+private:
+    Link* link;
+    staging_t* staging;
+    // Only the thread that owns the sending Link inserts
+    std::vector<Event*> events;
+    staging_t::NodeCache nodes;
+
+};
+
 } //namespace SST
 
 #endif // SST_CORE_THREADSYNCQUEUE_H
@@ -33,6 +33,7 @@ ThreadSyncSimpleSkip::ThreadSyncSimpleSkip(int num_threads, int thread, Simulati
     // TraceFunction trace(CALL_INFO_LONG);
     for ( int i = 0; i < num_threads; i++ ) {
         queues.push_back(new ThreadSyncQueue());
+        staging.push_back(new ThreadSyncDirectQueue::staging_t());
     }
 
     if ( sim->getRank().thread == 0 ) {
@@ -54,14 +55,21 @@ ThreadSyncSimpleSkip::~ThreadSyncSimpleSkip()
         Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncSimpleSkip total wait time: %lg seconds.\n", totalWaitTime);
     for ( int i = 0; i < num_threads; i++ ) {
         delete queues[i];
+        delete staging[i];
     }
     queues.clear();
+    staging.clear();
+    for ( auto& dq : direct_queues ) {
+        delete dq.second;
+    }
+    direct_queues.clear();
 }
 
 void
-ThreadSyncSimpleSkip::registerLink(LinkId_t link_id, Link* link)
+ThreadSyncSimpleSkip::registerLink(int to_thread, LinkId_t link_id, Link* link)
 {
     link_map[link_id] = link;
+    direct_queues[link_id] = new ThreadSyncDirectQueue(link, staging[to_thread]);
 }
 
 ActivityQueue*
@@ -70,24 +78,36 @@ ThreadSyncSimpleSkip::getQueueForThread(int tid)
     return queues[tid];
 }
 
+ActivityQueue*
+ThreadSyncSimpleSkip::getDirectQueueForLink(LinkId_t link_id)
+{
+    auto dq = direct_queues.find(link_id);
+    if ( dq == direct_queues.end() ) return nullptr;
+    return dq->second;
+}
+
+void
+ThreadSyncSimpleSkip::unregisterLink(LinkId_t link_id)
+{
+    link_map.erase(link_id);
+    auto dq = direct_queues.find(link_id);
+    if ( dq == direct_queues.end() ) return;
+    delete dq->second;
+    direct_queues.erase(dq);
+}
+
 void
 ThreadSyncSimpleSkip::before()
 {
-    // Empty all the queues and send events on the links
-    for ( size_t i = 0; i < queues.size(); i++ ) {
-        ThreadSyncQueue* queue = queues[i];
-        std::vector<Activity*>& vec = queue->getVector();
-        for ( size_t j = 0; j < vec.size(); j++ ) {
-            Event* ev = static_cast<Event*>(vec[j]);
-            auto link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
-            } else {
-                SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
-                link->second->send(delay,ev);
-            }
+    // Empty the staging areas in thread order, so that events for the
+    // same time and priority are delivered in the same order on every
+    // run.  Events have already been tagged with the link they arrived
+    // on.
+    Event* ev;
+    for ( auto* from : staging ) {
+        while ( from->try_remove(ev) ) {
+            deliverEvent(ev->getDeliveryLink(), ev);
         }
-        queue->clear();
     }
 }
 
@@ -49,8 +49,10 @@ public:
     void prepareForComplete() override;
 
     /** Register a Link which this Sync Object is responsible for */
-    void registerLink(LinkId_t link_id, Link* link) override;
+    void registerLink(int to_thread, LinkId_t link_id, Link* link) override;
     ActivityQueue* getQueueForThread(int tid) override;
+    ActivityQueue* getDirectQueueForLink(LinkId_t link_id) override;
+    void unregisterLink(LinkId_t link_id) override;
 
     uint64_t getDataSize() const;
 
@@ -59,6 +61,11 @@ public:
 private:
     std::vector<ThreadSyncQueue*> queues;
     std::unordered_map<LinkId_t, Link*> link_map;
+    /* Events sent to this thread during the run phase, with a staging
+     * area for each sending thread so they can be drained in thread
+     * order */
+    std::vector<ThreadSyncDirectQueue::staging_t*> staging;
+    std::unordered_map<LinkId_t, ThreadSyncDirectQueue*> direct_queues;
     SimTime_t my_max_period;
     int num_threads;
     int thread;
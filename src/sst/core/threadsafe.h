@@ -22,6 +22,7 @@
 #define sst_pause() __asm__ __volatile__ ( "or 27, 27, 27" ::: "memory" );
 #endif
 
+#include <algorithm>
 #include <thread>
 #include <atomic>
 #include <condition_variable>
@@ -30,7 +31,15 @@
 #include <vector>
 //#include <stdalign.h>
 
+#include <climits>
+#include <cstdlib>
+#include <new>
 #include <time.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "sst/core/profile.h"
 
@@ -50,14 +59,33 @@ namespace ThreadSafe {
 class CACHE_ALIGNED_T Barrier {
     size_t origCount;
     std::atomic<bool> enabled;
-    std::atomic<size_t> count, generation;
+    std::atomic<size_t> count;
+    /* Used as the futex word on Linux, so must be 32 bits */
+    std::atomic<uint32_t> generation;
+    /* Number of threads asleep waiting on generation */
+    std::atomic<uint32_t> sleepers;
+    /* Spins before going to sleep.  Tracks how long recent waits
+     * took, up to maxSpin(). */
+    std::atomic<uint32_t> spinBudget;
+
 public:
+    static const uint32_t DEFAULT_MAX_SPIN = 4096;
+    static const uint32_t MIN_SPIN = 16;
+
+#ifdef __SST_ENABLE_PROFILE__
+    /* Number of power of two buckets in the wait time histogram.
+     * Bucket i counts waits of less than 2^i microseconds, with the
+     * last bucket counting everything longer. */
+    static const int WAIT_BUCKETS = 24;
+#endif
+
     Barrier(size_t count) : origCount(count), enabled(true),
-            count(count), generation(0)
+            count(count), generation(0), sleepers(0), spinBudget(maxSpin().load())
     { }
 
     // Come g++ 4.7, this can become a delegating constructor
-    Barrier() : origCount(0), enabled(false), count(0), generation(0)
+    Barrier() : origCount(0), enabled(false), count(0), generation(0),
+            sleepers(0), spinBudget(maxSpin().load())
     { }
 
 
@@ -67,8 +95,13 @@ public:
         count = origCount = newCount;
         generation.store(0);
         enabled.store(true);
+        spinBudget.store(maxSpin().load());
     }
 
+    /** Upper limit on how long a thread spins in wait() before it
+     * goes to sleep.  0 always sleeps right away. */
+    static void setMaxSpin(uint32_t spins) { maxSpin() = spins; }
+
 
     /**
      * Wait for all threads to reach this point.
@@ -80,34 +113,26 @@ public:
         if ( enabled ) {
             auto startTime = SST::Core::Profile::now();
 
-            size_t gen = generation.load(std::memory_order_acquire);
+            uint32_t gen = generation.load(std::memory_order_acquire);
             asm("":::"memory");
             size_t c = count.fetch_sub(1) -1;
             if ( 0 == c ) {
                 /* We should release */
                 count.store(origCount);
                 asm("":::"memory");
-                /* Incrementing generation causes release */
-                generation.fetch_add(1, std::memory_order_release);
-                __sync_synchronize();
+                /* Incrementing generation causes release.  This is
+                 * ordered against the increment of sleepers in
+                 * waitForRelease(), so either the sleeper sees the new
+                 * generation or we see the sleeper. */
+                generation.fetch_add(1);
+                if ( sleepers.load() != 0 ) wakeAll();
             } else {
-                /* Try spinning first */
-                uint32_t count = 0;
-                do {
-                    count++;
-                    if ( count < 1024 ) {
-                        sst_pause();
-            } else if ( count < (1024*1024) ) {
-                        std::this_thread::yield();
-                    } else {
-                        struct timespec ts;
-                        ts.tv_sec = 0;
-                        ts.tv_nsec = 1000;
-                        nanosleep(&ts, nullptr);
-                    }
-                } while ( gen == generation.load(std::memory_order_acquire) );
+                waitForRelease(gen);
             }
             elapsed = SST::Core::Profile::getElapsed(startTime);
+#ifdef __SST_ENABLE_PROFILE__
+            recordWait(elapsed);
+#endif
         }
         return elapsed;
     }
@@ -117,6 +142,149 @@ public:
         enabled.store(false);
         count.store(0);
         ++generation;
+        wakeAll();
+    }
+
+#ifdef __SST_ENABLE_PROFILE__
+    /** Histogram of the time the calling thread has spent in wait(),
+     * over all Barriers */
+    static uint64_t* getWaitHistogram()
+    {
+        static thread_local uint64_t histogram[WAIT_BUCKETS] = { 0 };
+        return histogram;
+    }
+#endif
+
+private:
+    friend class Waiter;
+
+    static std::atomic<uint32_t>& maxSpin()
+    {
+        static std::atomic<uint32_t> spins(DEFAULT_MAX_SPIN);
+        return spins;
+    }
+
+    void waitForRelease(uint32_t gen)
+    {
+        /* Try spinning first.  The limit may have been lowered
+         * since the budget was set (static Barriers are constructed
+         * before setMaxSpin() is called). */
+        uint32_t budget = std::min(spinBudget.load(std::memory_order_relaxed),
+                maxSpin().load(std::memory_order_relaxed));
+        for ( uint32_t spins = 0; spins < budget; spins++ ) {
+            if ( gen != generation.load(std::memory_order_acquire) ) {
+                /* Released while spinning.  Aim to spin about twice
+                 * as long as this wait took. */
+                adaptSpin(budget, 2 * spins);
+                return;
+            }
+            sst_pause();
+        }
+
+        /* The wait is longer than the budget, so the spinning was
+         * wasted.  Spin less next time. */
+        adaptSpin(budget, budget / 2);
+        sleepers.fetch_add(1);
+        while ( gen == generation.load(std::memory_order_acquire) ) {
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&generation), FUTEX_WAIT_PRIVATE, gen, nullptr, nullptr, 0);
+#else
+            std::this_thread::yield();
+#endif
+        }
+        sleepers.fetch_sub(1);
+    }
+
+    void wakeAll()
+    {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&generation), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    void adaptSpin(uint32_t budget, uint32_t target)
+    {
+        spinBudget.store(nextSpin(budget, target), std::memory_order_relaxed);
+    }
+
+    static uint32_t nextSpin(uint32_t budget, uint32_t target)
+    {
+        uint64_t next = (7 * (uint64_t)budget + target) / 8;
+        uint64_t floor = MIN_SPIN;
+        uint32_t limit = maxSpin().load(std::memory_order_relaxed);
+        if ( next < floor ) next = floor;
+        if ( next > limit ) next = limit;
+        return next;
+    }
+
+#ifdef __SST_ENABLE_PROFILE__
+    static void recordWait(double elapsed)
+    {
+        uint64_t usec = elapsed * 1e6;
+        int bucket = 0;
+        while ( bucket < WAIT_BUCKETS - 1 && usec >= (1ull << bucket) ) bucket++;
+        getWaitHistogram()[bucket]++;
+    }
+#endif
+};
+
+
+/**
+ * Lets one thread wait for others to change something it is watching.
+ * The waiter spins with the same adaptive budget as Barrier, then
+ * sleeps on a futex.  Whoever makes the change calls notify()
+ * afterwards, which only costs a fence unless the waiter is asleep.
+ */
+class CACHE_ALIGNED_T Waiter {
+    /* Used as the futex word on Linux, so must be 32 bits */
+    std::atomic<uint32_t> generation;
+    std::atomic<uint32_t> sleeping;
+    /* Only used by the waiting thread */
+    uint32_t spinBudget;
+
+public:
+    Waiter() : generation(0), sleeping(0), spinBudget(Barrier::maxSpin().load()) { }
+
+    /** Wait until ready() returns true.  Only one thread may wait on a
+     * Waiter. */
+    template<typename F>
+    void waitUntil(F ready)
+    {
+        uint32_t budget = std::min(spinBudget, Barrier::maxSpin().load(std::memory_order_relaxed));
+        for ( uint32_t spins = 0; spins < budget; spins++ ) {
+            if ( ready() ) {
+                spinBudget = Barrier::nextSpin(budget, 2 * spins);
+                return;
+            }
+            sst_pause();
+        }
+        spinBudget = Barrier::nextSpin(budget, budget / 2);
+
+        /* Ordered against the fence in notify(), so either the
+         * notifier sees sleeping or ready() sees its change */
+        sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while ( true ) {
+            uint32_t gen = generation.load(std::memory_order_acquire);
+            if ( ready() ) break;
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&generation), FUTEX_WAIT_PRIVATE, gen, nullptr, nullptr, 0);
+#else
+            std::this_thread::yield();
+#endif
+        }
+        sleeping.store(0, std::memory_order_relaxed);
+    }
+
+    /** Wake the waiting thread if it is asleep */
+    void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ( sleeping.load(std::memory_order_relaxed) == 0 ) return;
+        generation.fetch_add(1);
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&generation), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
     }
 };
 
@@ -313,6 +481,136 @@ public:
 
 };
 
+/**
+ * Unbounded multiple-producer, single-consumer queue.  insert() is
+ * wait-free and may be called from any thread.  Only one thread may
+ * call try_remove().  An insert that is still in progress may not be
+ * visible to the consumer, so the consumer should only assume the
+ * queue has been drained once producers have synchronized with it
+ * (e.g. through a Barrier).  Items from different producers come out
+ * in the order they were inserted in real time, so a consumer that
+ * needs a repeatable order should give each producer its own queue.
+ *
+ * Nodes are recycled rather than freed: the consumer pushes each node
+ * it is done with onto a free stack, and a producer takes the whole
+ * stack into its NodeCache when the cache runs dry.  Only the
+ * consumer pushes and producers only take the whole stack, so the
+ * stack is not exposed to ABA.
+ */
+template<typename T>
+class MPSCQueue {
+    struct Node {
+        std::atomic<Node*> next;
+        T data;
+
+        Node() : next(nullptr) { }
+    };
+
+    CACHE_ALIGNED(std::atomic<Node*>, last);
+    CACHE_ALIGNED(Node*, first);
+    CACHE_ALIGNED(std::atomic<Node*>, free_nodes);
+
+    static void deleteList(Node* node) {
+        while ( node != nullptr ) {
+            Node* tmp = node;
+            node = tmp->next.load(std::memory_order_relaxed);
+            delete tmp;
+        }
+    }
+
+public:
+    /** Nodes held by a single producer.  Each producer passes its own
+     * cache to insert(). */
+    class NodeCache {
+        friend class MPSCQueue;
+        Node* head;
+    public:
+        NodeCache() : head(nullptr) { }
+        ~NodeCache() { deleteList(head); }
+    };
+
+    MPSCQueue() {
+        /* 'first' is a dummy value */
+        first = new Node();
+        last.store(first);
+        free_nodes.store(nullptr);
+    }
+
+    ~MPSCQueue() {
+        deleteList(first);               // release the list
+        deleteList(free_nodes.load(std::memory_order_relaxed));
+    }
+
+    /* Plain new only honours the alignment of the members from C++17 */
+    static void* operator new(std::size_t size) {
+        void* ptr;
+        if ( posix_memalign(&ptr, 64, size) != 0 ) throw std::bad_alloc();
+        return ptr;
+    }
+
+    static void operator delete(void* ptr) {
+        free(ptr);
+    }
+
+    bool empty() const {
+        return first->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    void insert(const T& t, NodeCache& cache) {
+        Node* tmp = allocNode(cache);
+        tmp->data = t;
+        Node* prev = last.exchange(tmp, std::memory_order_acq_rel);
+        prev->next.store(tmp, std::memory_order_release);   // publish to consumer
+    }
+
+    /** Insert all of items with a single exchange, so the consumer
+     * sees them together and in order */
+    void insert(const std::vector<T>& items, NodeCache& cache) {
+        if ( items.empty() ) return;
+        Node* head = allocNode(cache);
+        head->data = items[0];
+        Node* tail = head;
+        for ( size_t i = 1; i < items.size(); i++ ) {
+            Node* tmp = allocNode(cache);
+            tmp->data = items[i];
+            tail->next.store(tmp, std::memory_order_relaxed);
+            tail = tmp;
+        }
+        Node* prev = last.exchange(tail, std::memory_order_acq_rel);
+        prev->next.store(head, std::memory_order_release);   // publish to consumer
+    }
+
+    bool try_remove(T& result) {
+        Node* theFirst = first;
+        Node* theNext = first->next.load(std::memory_order_acquire);
+        if ( theNext != nullptr ) {      // if queue is nonempty
+            result = theNext->data;      // take it out
+            first = theNext;             // swing first forward
+            // Recycle the old dummy.  Its producer is done with it,
+            // since its next has been published.
+            Node* head = free_nodes.load(std::memory_order_relaxed);
+            do {
+                theFirst->next.store(head, std::memory_order_relaxed);
+            } while ( !free_nodes.compare_exchange_weak(head, theFirst, std::memory_order_release, std::memory_order_relaxed) );
+            return true;
+        }
+        return false;
+    }
+
+private:
+    Node* allocNode(NodeCache& cache) {
+        if ( cache.head == nullptr ) {
+            cache.head = free_nodes.exchange(nullptr, std::memory_order_acquire);
+            if ( cache.head == nullptr ) return new Node();
+        }
+        Node* node = cache.head;
+        cache.head = node->next.load(std::memory_order_relaxed);
+        node->next.store(nullptr, std::memory_order_relaxed);
+        return node;
+    }
+
+};
+
 }
 }
 }
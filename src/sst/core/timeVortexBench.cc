@@ -0,0 +1,446 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * sst-bench-timevortex: micro-benchmark for the TimeVortex
+ * implementations registered with the core.
+ *
+ * Each run fills a TimeVortex to the requested depth and then performs
+ * hold operations (pop the next activity, advance its delivery time,
+ * insert it again) so that the depth stays constant.  Pops and inserts
+ * are done in rounds so they can be timed separately.
+ */
+
+#include "sst_config.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "sst/core/action.h"
+#include "sst/core/params.h"
+#include "sst/core/timeVortex.h"
+
+using namespace SST;
+
+namespace {
+
+/** Activity used to populate the TimeVortex */
+class BenchActivity : public Action {
+public:
+    BenchActivity() : Action() {}
+    void execute(void) override {}
+
+    using Activity::setPriority;
+
+    NotSerializable(BenchActivity)
+};
+
+enum Model_t { HOLD, PHOLD, BURST };
+
+struct BenchConfig {
+    std::vector<std::string> timeVortex;
+    std::vector<uint64_t> depths;
+    Model_t model;
+    uint64_t ops;
+    uint64_t round;
+    SimTime_t mean;
+    SimTime_t lookahead;
+    double far;
+    uint64_t seed;
+
+    BenchConfig() :
+        model(HOLD),
+        ops(1000000),
+        round(64),
+        mean(1000),
+        lookahead(100),
+        far(0.0),
+        seed(1)
+    {}
+};
+
+/** Generates the delivery time increments for a model */
+class Workload {
+public:
+    Workload(const BenchConfig& cfg) :
+        cfg(cfg),
+        rng(cfg.seed),
+        expo(1.0 / cfg.mean),
+        unit(0.0, 1.0)
+    {}
+
+    SimTime_t increment() {
+        if ( cfg.far > 0.0 && unit(rng) < cfg.far ) {
+            // Far-future timeout
+            return 1000 * cfg.mean + (SimTime_t)expo(rng);
+        }
+        switch ( cfg.model ) {
+        case HOLD:
+            return (SimTime_t)expo(rng);
+        case PHOLD:
+            return cfg.lookahead + (SimTime_t)expo(rng);
+        case BURST:
+            // Clock-like: everything lands on a multiple of the mean
+            return cfg.mean * (1 + rng() % 4);
+        }
+        return 0;
+    }
+
+    /** Priority of a new activity.  PHOLD mixes in a few priorities
+     * to exercise tie breaking. */
+    int priority() {
+        if ( cfg.model == PHOLD ) return EVENTPRIORITY + (rng() % 3) * 10 - 10;
+        return EVENTPRIORITY;
+    }
+
+private:
+    const BenchConfig& cfg;
+    std::mt19937_64 rng;
+    std::exponential_distribution<double> expo;
+    std::uniform_real_distribution<double> unit;
+};
+
+/** Counts last-level cache misses with perf_event, where available */
+class CacheMissCounter {
+public:
+    CacheMissCounter() : fd(-1) {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter() {
+        if ( fd >= 0 ) close(fd);
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        if ( fd < 0 ) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if ( fd < 0 ) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if ( read(fd, &count, sizeof(count)) != sizeof(count) ) count = 0;
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+/** Current resident set size in kB, or 0 if unknown */
+uint64_t currentRSS()
+{
+    uint64_t rss = 0;
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if ( fp != nullptr ) {
+        unsigned long size, resident;
+        if ( fscanf(fp, "%lu %lu", &size, &resident) == 2 ) {
+            rss = (uint64_t)resident * (sysconf(_SC_PAGESIZE) / 1024);
+        }
+        fclose(fp);
+    }
+    return rss;
+}
+
+TimeVortex* createTimeVortex(const std::string& type, Params& params)
+{
+    // Only TimeVortices built into the core are available; element
+    // libraries are not loaded
+    size_t dot = type.find('.');
+    if ( dot == std::string::npos ) return nullptr;
+    auto* lib = TimeVortex::getBuilderLibrary(type.substr(0, dot));
+    if ( lib == nullptr ) return nullptr;
+    auto* builder = lib->getBuilder(type.substr(dot + 1));
+    if ( builder == nullptr ) return nullptr;
+    return builder->create(params);
+}
+
+void listTimeVortices()
+{
+    auto* lib = TimeVortex::getBuilderLibrary("sst");
+    if ( lib == nullptr ) return;
+    for ( auto& entry : lib->getMap() ) {
+        printf("  sst.%s\n", entry.first.c_str());
+    }
+}
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsedNS(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+bool runBenchmark(const BenchConfig& cfg, const std::string& type, uint64_t depth, CacheMissCounter& misses)
+{
+    Params params;
+    uint64_t rss_before = currentRSS();
+    TimeVortex* tv = createTimeVortex(type, params);
+    if ( tv == nullptr ) {
+        fprintf(stderr, "ERROR: Unknown TimeVortex: %s\n", type.c_str());
+        return false;
+    }
+
+    Workload work(cfg);
+    SimTime_t now = 0;
+
+    for ( uint64_t i = 0; i < depth; i++ ) {
+        BenchActivity* act = new BenchActivity();
+        act->setDeliveryTime(work.increment());
+        act->setPriority(work.priority());
+        tv->insert(act);
+    }
+    uint64_t rss = currentRSS();
+    rss = rss > rss_before ? rss - rss_before : 0;
+
+    std::vector<BenchActivity*> held;
+    held.reserve(cfg.round);
+    double pop_ns = 0.0;
+    double insert_ns = 0.0;
+    uint64_t pops = 0;
+    uint64_t cache_misses = 0;
+
+    // First pass warms up the queue, second pass is measured
+    for ( int pass = 0; pass < 2; pass++ ) {
+        if ( pass == 1 ) misses.start();
+        uint64_t done = 0;
+        while ( done < cfg.ops ) {
+            uint64_t count = std::min(cfg.round, std::min(cfg.ops - done, depth));
+
+            auto start = bench_clock::now();
+            for ( uint64_t i = 0; i < count; i++ ) {
+                held.push_back(static_cast<BenchActivity*>(tv->pop()));
+            }
+            double t_pop = elapsedNS(start);
+
+            now = held.back()->getDeliveryTime();
+            for ( auto* act : held ) {
+                act->setDeliveryTime(now + work.increment());
+                act->setPriority(work.priority());
+            }
+
+            start = bench_clock::now();
+            for ( auto* act : held ) {
+                tv->insert(act);
+            }
+            double t_insert = elapsedNS(start);
+            held.clear();
+
+            if ( pass == 1 ) {
+                pop_ns += t_pop;
+                insert_ns += t_insert;
+                pops += count;
+            }
+            done += count;
+        }
+        if ( pass == 1 ) cache_misses = misses.stop();
+    }
+
+    const char* model = cfg.model == HOLD ? "hold" : (cfg.model == PHOLD ? "phold" : "burst");
+    std::string miss_str = "n/a";
+    if ( misses.available() ) {
+        std::ostringstream ss;
+        ss.precision(3);
+        ss << std::fixed << (double)cache_misses / pops;
+        miss_str = ss.str();
+    }
+    printf("%-36s %-6s %10" PRIu64 " %12.1f %12.1f %12" PRIu64 " %14s\n",
+           type.c_str(), model, depth, pop_ns / pops, insert_ns / pops, rss, miss_str.c_str());
+
+    delete tv;
+    return true;
+}
+
+template <typename T>
+std::vector<T> splitList(const std::string& str)
+{
+    std::vector<T> ret;
+    std::stringstream ss(str);
+    std::string item;
+    while ( std::getline(ss, item, ',') ) {
+        if ( item.empty() ) continue;
+        std::stringstream conv(item);
+        T val;
+        conv >> val;
+        ret.push_back(val);
+    }
+    return ret;
+}
+
+void outputUsage(const char* app)
+{
+    printf("Usage: %s [options]\n", app);
+    printf("Options:\n");
+    printf("  -h, --help               Print help message\n");
+    printf("  -l, --list               List the available TimeVortex implementations\n");
+    printf("  -t, --timeVortex=LIST    Comma separated list of TimeVortex implementations\n");
+    printf("                           (default: all built-in implementations)\n");
+    printf("  -d, --depth=LIST         Comma separated list of queue depths (default: 1000,100000)\n");
+    printf("  -m, --model=MODEL        Workload {hold, phold, burst} (default: hold)\n");
+    printf("                             hold:  exponential increments\n");
+    printf("                             phold: lookahead plus exponential increments, mixed priorities\n");
+    printf("                             burst: increments are multiples of the mean, so many\n");
+    printf("                                    activities share a delivery time\n");
+    printf("  -n, --ops=N              Number of hold operations per run (default: 1000000)\n");
+    printf("  -r, --round=N            Activities popped before they are reinserted (default: 64)\n");
+    printf("      --mean=N             Mean increment in core cycles (default: 1000)\n");
+    printf("      --lookahead=N        Minimum increment for phold (default: 100)\n");
+    printf("      --far=F              Fraction of activities scheduled far in the future (default: 0)\n");
+    printf("      --seed=N             Random seed (default: 1)\n");
+    printf("\n");
+    printf("Reports ns per pop, ns per insert, resident memory growth while filling\n");
+    printf("the queue, and cache misses per hold operation (from perf_event, if available).\n");
+}
+
+int parseCmdLine(int argc, char* argv[], BenchConfig& cfg)
+{
+    static const struct option longOpts[] = {
+        {"help",        no_argument,        nullptr, 'h'},
+        {"list",        no_argument,        nullptr, 'l'},
+        {"timeVortex",  required_argument,  nullptr, 't'},
+        {"depth",       required_argument,  nullptr, 'd'},
+        {"model",       required_argument,  nullptr, 'm'},
+        {"ops",         required_argument,  nullptr, 'n'},
+        {"round",       required_argument,  nullptr, 'r'},
+        {"mean",        required_argument,  nullptr, 0},
+        {"lookahead",   required_argument,  nullptr, 0},
+        {"far",         required_argument,  nullptr, 0},
+        {"seed",        required_argument,  nullptr, 0},
+        {nullptr, 0, nullptr, 0}
+    };
+    while (1) {
+        int opt_idx = 0;
+        const int intC = getopt_long(argc, argv, "hlt:d:m:n:r:", longOpts, &opt_idx);
+        if ( intC == -1 )
+            break;
+
+        const char c = static_cast<char>(intC);
+
+        switch (c) {
+        case 'h':
+            outputUsage(argv[0]);
+            return 1;
+        case 'l':
+            listTimeVortices();
+            return 1;
+        case 't':
+            cfg.timeVortex = splitList<std::string>(optarg);
+            break;
+        case 'd':
+            cfg.depths = splitList<uint64_t>(optarg);
+            break;
+        case 'm':
+            if ( !strcmp(optarg, "hold") ) cfg.model = HOLD;
+            else if ( !strcmp(optarg, "phold") ) cfg.model = PHOLD;
+            else if ( !strcmp(optarg, "burst") ) cfg.model = BURST;
+            else {
+                fprintf(stderr, "ERROR: Unknown model: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'n':
+            cfg.ops = strtoull(optarg, nullptr, 0);
+            break;
+        case 'r':
+            cfg.round = strtoull(optarg, nullptr, 0);
+            break;
+        case 0:
+            if ( !strcmp(longOpts[opt_idx].name, "mean") ) {
+                cfg.mean = strtoull(optarg, nullptr, 0);
+            }
+            else if ( !strcmp(longOpts[opt_idx].name, "lookahead") ) {
+                cfg.lookahead = strtoull(optarg, nullptr, 0);
+            }
+            else if ( !strcmp(longOpts[opt_idx].name, "far") ) {
+                cfg.far = strtod(optarg, nullptr);
+            }
+            else if ( !strcmp(longOpts[opt_idx].name, "seed") ) {
+                cfg.seed = strtoull(optarg, nullptr, 0);
+            }
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if ( cfg.mean == 0 || cfg.round == 0 ) {
+        fprintf(stderr, "ERROR: --mean and --round must be greater than 0\n");
+        return -1;
+    }
+
+    if ( cfg.timeVortex.empty() ) {
+        auto* lib = TimeVortex::getBuilderLibrary("sst");
+        if ( lib != nullptr ) {
+            for ( auto& entry : lib->getMap() ) {
+                cfg.timeVortex.push_back("sst." + entry.first);
+            }
+        }
+    }
+    if ( cfg.depths.empty() ) {
+        cfg.depths.push_back(1000);
+        cfg.depths.push_back(100000);
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    BenchConfig cfg;
+    int ret = parseCmdLine(argc, argv, cfg);
+    if ( ret != 0 ) return ret < 0 ? 1 : 0;
+
+    CacheMissCounter misses;
+
+    printf("%-36s %-6s %10s %12s %12s %12s %14s\n",
+           "TimeVortex", "model", "depth", "ns/pop", "ns/insert", "RSS (kB)", "misses/op");
+    for ( auto& type : cfg.timeVortex ) {
+        for ( auto depth : cfg.depths ) {
+            if ( depth == 0 ) continue;
+            if ( !runBenchmark(cfg, type, depth, misses) ) return 1;
+        }
+    }
+    return 0;
+}